@@ -0,0 +1,731 @@
+/*
+ * Benchmarks for the concurrent linked list.
+ *
+ * Each workload prints one CSV row per configuration so results can be
+ * charted directly:
+ *
+ *   workload,variant,threads,ops,seconds,ops_per_sec,p50_ns,p99_ns,p999_ns,max_ns,
+ *   cycles_per_op,instructions_per_op,cache_refs_per_op,cache_misses_per_op,
+ *   l1d_misses_per_op,dtlb_misses_per_op
+ *
+ * The latency columns are only filled by workloads that time single
+ * operations. The hardware counter columns are left empty for counters
+ * perf_event_open() cannot provide (no PMU, perf_event_paranoid, non-Linux).
+ *
+ * Usage: concurrent_ll_bench [--filter NAME] [--threads N] [--seconds S]
+ *
+ *   --filter   Only run workloads whose name contains NAME
+ *   --threads  Largest thread count to sweep (default: hardware threads)
+ *   --seconds  Duration of each measurement (default: 1.0)
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "list_cxx.h"
+
+struct bench_options {
+    const char *filter = nullptr;
+    int max_threads = 1;
+    double seconds = 1.0;
+};
+
+/*
+ * Log-linear latency histogram: 8 sub-buckets per power of two, so any
+ * reported percentile is within 12.5% of the true value.
+ */
+struct latency_histogram {
+    static constexpr int sub_bits = 3;
+    static constexpr int buckets = (64 - sub_bits) << sub_bits;
+    std::array<uint64_t, buckets> counts{};
+    uint64_t max_ns = 0;
+
+    static int bucket(uint64_t ns)
+    {
+        if (ns < (1u << sub_bits))
+            return static_cast<int>(ns);
+        int msb = 63 - __builtin_clzll(ns);
+        int shift = msb - sub_bits;
+        return ((shift + 1) << sub_bits) + static_cast<int>((ns >> shift) & ((1u << sub_bits) - 1));
+    }
+
+    /* Largest value that lands in bucket b. */
+    static uint64_t bucket_limit(int b)
+    {
+        if (b < (1 << sub_bits))
+            return static_cast<uint64_t>(b);
+        int shift = (b >> sub_bits) - 1;
+        uint64_t base = (uint64_t{1} << sub_bits) | (b & ((1 << sub_bits) - 1));
+        return ((base + 1) << shift) - 1;
+    }
+
+    void record(uint64_t ns)
+    {
+        counts[bucket(ns)]++;
+        max_ns = std::max(max_ns, ns);
+    }
+
+    void merge(const latency_histogram &other)
+    {
+        for (int b = 0; b < buckets; b++)
+            counts[b] += other.counts[b];
+        max_ns = std::max(max_ns, other.max_ns);
+    }
+
+    uint64_t percentile(double p) const
+    {
+        uint64_t total = 0;
+        for (uint64_t c : counts)
+            total += c;
+        uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(total));
+        uint64_t seen = 0;
+        for (int b = 0; b < buckets; b++) {
+            seen += counts[b];
+            if (seen > rank)
+                return std::min(bucket_limit(b), max_ns);
+        }
+        return max_ns;
+    }
+};
+
+/* Hardware counters read around each worker, in CSV column order. */
+enum perf_counter {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_REFS,
+    PERF_CACHE_MISSES,
+    PERF_L1D_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_COUNTERS
+};
+
+/* Counter totals; valid[c] is false if any thread could not read c. */
+struct perf_values {
+    std::array<double, PERF_COUNTERS> count{};
+    std::array<bool, PERF_COUNTERS> valid{};
+    bool empty = true;
+
+    void merge(const perf_values &other)
+    {
+        for (int c = 0; c < PERF_COUNTERS; c++) {
+            count[c] += other.count[c];
+            valid[c] = (empty || valid[c]) && other.valid[c];
+        }
+        empty = false;
+    }
+};
+
+/*
+ * The calling thread's counters, user space only, from construction until
+ * read(). Threads it starts meanwhile are included once they exit. Events
+ * the kernel refuses stay closed; counts of events that had to share the
+ * PMU are scaled up by the fraction of time they ran.
+ */
+struct perf_session {
+    std::array<int, PERF_COUNTERS> fds;
+
+    perf_session()
+    {
+        fds.fill(-1);
+#ifdef __linux__
+        static const struct {
+            uint32_t type;
+            uint64_t config;
+        } events[PERF_COUNTERS] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        };
+        for (int c = 0; c < PERF_COUNTERS; c++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events[c].type;
+            attr.config = events[c].config;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[c] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+        for (int fd : fds) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    ~perf_session()
+    {
+#ifdef __linux__
+        for (int fd : fds)
+            if (fd >= 0)
+                close(fd);
+#endif
+    }
+
+    perf_session(const perf_session &) = delete;
+    perf_session &operator=(const perf_session &) = delete;
+
+    perf_values read() const
+    {
+        perf_values v;
+        v.empty = false;
+#ifdef __linux__
+        for (int c = 0; c < PERF_COUNTERS; c++) {
+            uint64_t buf[3];  /* value, time enabled, time running */
+            if (fds[c] < 0 || ::read(fds[c], buf, sizeof(buf)) != sizeof(buf) || buf[2] == 0)
+                continue;
+            v.count[c] = static_cast<double>(buf[0]) * static_cast<double>(buf[1]) /
+                         static_cast<double>(buf[2]);
+            v.valid[c] = true;
+        }
+#endif
+        return v;
+    }
+};
+
+/* perf_values of several threads, merged as each finishes. */
+struct perf_totals {
+    std::mutex lock;
+    perf_values values;
+
+    void add(const perf_values &v)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        values.merge(v);
+    }
+};
+
+struct bench_result {
+    uint64_t ops = 0;
+    double seconds = 0.0;
+    const latency_histogram *latency = nullptr;
+    perf_values perf;
+};
+
+static void
+report(const char *workload, const char *variant, int threads, const bench_result &r)
+{
+    double rate = r.seconds > 0.0 ? static_cast<double>(r.ops) / r.seconds : 0.0;
+    std::printf("%s,%s,%d,%llu,%.3f,%.0f", workload, variant, threads,
+                static_cast<unsigned long long>(r.ops), r.seconds, rate);
+    if (r.latency) {
+        std::printf(",%llu,%llu,%llu,%llu",
+                    static_cast<unsigned long long>(r.latency->percentile(0.50)),
+                    static_cast<unsigned long long>(r.latency->percentile(0.99)),
+                    static_cast<unsigned long long>(r.latency->percentile(0.999)),
+                    static_cast<unsigned long long>(r.latency->max_ns));
+    } else {
+        std::printf(",,,,");
+    }
+    for (int c = 0; c < PERF_COUNTERS; c++) {
+        if (r.perf.valid[c] && r.ops > 0)
+            std::printf(",%.2f", r.perf.count[c] / static_cast<double>(r.ops));
+        else
+            std::printf(",");
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+/* Thread counts 1, 2, 4, ... up to and including max_threads. */
+static std::vector<int>
+thread_counts(const bench_options &opt)
+{
+    std::vector<int> counts;
+    for (int n = 1; n < opt.max_threads; n *= 2)
+        counts.push_back(n);
+    counts.push_back(opt.max_threads);
+    return counts;
+}
+
+/*
+ * Run body(thread_index, stop) on num_threads threads for opt.seconds.
+ * Each body returns the number of operations it completed, and its
+ * hardware counters are summed into the result.
+ */
+template <typename Body>
+static bench_result
+run_timed(const bench_options &opt, int num_threads, Body body)
+{
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> total{0};
+    perf_totals perf;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            while (!start.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            perf_session session;
+            total.fetch_add(body(t, stop), std::memory_order_relaxed);
+            perf.add(session.read());
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::duration<double>(opt.seconds));
+    stop.store(true, std::memory_order_release);
+    for (auto &t : threads)
+        t.join();
+    auto end = std::chrono::steady_clock::now();
+
+    bench_result r;
+    r.ops = total.load();
+    r.seconds = std::chrono::duration<double>(end - begin).count();
+    r.perf = perf.values;
+    return r;
+}
+
+/* ==================== Workloads ==================== */
+
+/*
+ * Thread churn: each driver thread repeatedly spawns a short-lived worker
+ * that registers, performs one insert/remove_first pair, and unregisters.
+ * The "parked" variant keeps many other slots registered for the whole run,
+ * which is where slot lookup cost used to grow with the domain size.
+ */
+static void
+bench_thread_churn(const bench_options &opt)
+{
+    static const int parked_counts[] = {0, 256};
+
+    for (int parked : parked_counts) {
+        char variant[32];
+        std::snprintf(variant, sizeof(variant), "parked=%d", parked);
+
+        for (int n : thread_counts(opt)) {
+            ll_domain_t *domain = ll_domain_create(0);
+            ll_head_t list;
+            ll_init(&list, domain);
+
+            std::atomic<bool> release{false};
+            std::atomic<int> registered{0};
+            std::vector<std::thread> parked_threads;
+            for (int p = 0; p < parked; p++) {
+                parked_threads.emplace_back([&]() {
+                    ll_thread_register(domain);
+                    registered.fetch_add(1);
+                    while (!release.load(std::memory_order_acquire))
+                        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    ll_thread_unregister(domain);
+                });
+            }
+            while (registered.load() < parked)
+                std::this_thread::yield();
+
+            int item = 0;
+            bench_result r = run_timed(opt, n, [&](int, std::atomic<bool> &stop) {
+                uint64_t ops = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    std::thread worker([&]() {
+                        ll_thread_register(domain);
+                        void *out = nullptr;
+                        ll_insert_head(&list, &item);
+                        ll_remove_first(&list, &out);
+                        ll_thread_unregister(domain);
+                    });
+                    worker.join();
+                    ops++;
+                }
+                return ops;
+            });
+            report("thread_churn", variant, n, r);
+
+            release.store(true, std::memory_order_release);
+            for (auto &t : parked_threads)
+                t.join();
+
+            ll_thread_register(domain);
+            ll_destroy(&list, nullptr);
+            ll_thread_unregister(domain);
+            ll_domain_destroy(domain);
+        }
+    }
+}
+
+/*
+ * Head contention: every thread hammers one list with insert_head /
+ * remove_first pairs, so nearly all work is CAS retries on the head word.
+ * One variant per backoff policy, plus flat-combining and elimination
+ * lists; compare
+ * throughput as threads grow past the number of CPUs.
+ */
+static void
+bench_contention(const bench_options &opt)
+{
+    static const struct {
+        const char *name;
+        ll_backoff_t policy;
+        unsigned list_flags;
+    } variants[] = {
+        {"none", LL_BACKOFF_NONE, 0},
+        {"exponential", LL_BACKOFF_EXPONENTIAL, 0},
+        {"random", LL_BACKOFF_RANDOM, 0},
+        {"auto", LL_BACKOFF_AUTO, 0},
+        {"combining", LL_BACKOFF_AUTO, LL_LIST_COMBINING},
+        {"elimination", LL_BACKOFF_AUTO, LL_LIST_ELIMINATION},
+    };
+
+    for (const auto &v : variants) {
+        for (int n : thread_counts(opt)) {
+            ll_domain_config_t config = {};
+            config.backoff = v.policy;
+            ll_domain_t *domain = ll_domain_create_ex(&config);
+            ll_list_config_t list_config = {};
+            list_config.flags = v.list_flags;
+            ll_head_t list;
+            ll_init_ex(&list, domain, &list_config);
+
+            int item = 0;
+            bench_result r = run_timed(opt, n, [&](int, std::atomic<bool> &stop) {
+                ll_thread_register(domain);
+                uint64_t ops = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    void *out = nullptr;
+                    ll_insert_head(&list, &item);
+                    ll_remove_first(&list, &out);
+                    ops += 2;
+                }
+                ll_thread_unregister(domain);
+                return ops;
+            });
+            report("contention", v.name, n, r);
+
+            ll_thread_register(domain);
+            ll_destroy(&list, nullptr);
+            ll_thread_unregister(domain);
+            ll_domain_destroy(domain);
+        }
+    }
+}
+
+/*
+ * Insert bursts: every thread inserts a batch, then pops the same number
+ * back, so reads are rare next to inserts. Compares a plain list with
+ * striped and per-CPU buffered lists.
+ */
+static void
+bench_insert_burst(const bench_options &opt)
+{
+    static const int batch = 256;
+    static const struct {
+        const char *name;
+        unsigned list_flags;
+    } variants[] = {
+        {"plain", 0},
+        {"striped", LL_LIST_STRIPED},
+        {"percpu", LL_LIST_PERCPU},
+    };
+
+    for (const auto &v : variants) {
+        for (int n : thread_counts(opt)) {
+            ll_domain_t *domain = ll_domain_create(0);
+            ll_list_config_t list_config = {};
+            list_config.flags = v.list_flags;
+            ll_head_t list;
+            ll_init_ex(&list, domain, &list_config);
+
+            int item = 0;
+            bench_result r = run_timed(opt, n, [&](int, std::atomic<bool> &stop) {
+                ll_thread_register(domain);
+                uint64_t ops = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (int i = 0; i < batch; i++)
+                        ll_insert_head(&list, &item);
+                    void *out = nullptr;
+                    for (int i = 0; i < batch; i++)
+                        ll_remove_first(&list, &out);
+                    ops += 2 * batch;
+                }
+                ll_thread_unregister(domain);
+                return ops;
+            });
+            report("insert_burst", v.name, n, r);
+
+            ll_thread_register(domain);
+            ll_destroy(&list, nullptr);
+            ll_thread_unregister(domain);
+            ll_domain_destroy(domain);
+        }
+    }
+}
+
+/*
+ * Insert tail latency: every thread times each ll_insert_head() on one
+ * shared list (popping its batch back between rounds, untimed). Compares
+ * the CAS retry loop of a plain list with LL_LIST_WAITFREE, whose insert
+ * is a single exchange.
+ */
+static void
+bench_insert_latency(const bench_options &opt)
+{
+    static const int batch = 256;
+    static const struct {
+        const char *name;
+        unsigned list_flags;
+    } variants[] = {
+        {"cas", 0},
+        {"waitfree", LL_LIST_WAITFREE},
+    };
+
+    for (const auto &v : variants) {
+        for (int n : thread_counts(opt)) {
+            ll_domain_t *domain = ll_domain_create(0);
+            ll_list_config_t list_config = {};
+            list_config.flags = v.list_flags;
+            ll_head_t list;
+            ll_init_ex(&list, domain, &list_config);
+
+            std::vector<latency_histogram> hists(n);
+            int item = 0;
+            bench_result r = run_timed(opt, n, [&](int t, std::atomic<bool> &stop) {
+                ll_thread_register(domain);
+                latency_histogram &h = hists[t];
+                uint64_t ops = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (int i = 0; i < batch; i++) {
+                        auto begin = std::chrono::steady_clock::now();
+                        ll_insert_head(&list, &item);
+                        auto end = std::chrono::steady_clock::now();
+                        h.record(static_cast<uint64_t>(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
+                                .count()));
+                    }
+                    void *out = nullptr;
+                    for (int i = 0; i < batch; i++)
+                        ll_remove_first(&list, &out);
+                    ops += batch;
+                }
+                ll_thread_unregister(domain);
+                return ops;
+            });
+            latency_histogram all;
+            for (const latency_histogram &h : hists)
+                all.merge(h);
+            r.latency = &all;
+            report("insert_latency", v.name, n, r);
+
+            ll_thread_register(domain);
+            ll_destroy(&list, nullptr);
+            ll_thread_unregister(domain);
+            ll_domain_destroy(domain);
+        }
+    }
+}
+
+/*
+ * Read-mostly traversal: readers iterate a 1000-element list while, from
+ * two threads up, thread 0 rotates an element and reclaims every so often.
+ * Counts elements visited by readers. Compares seq_cst fences on every
+ * hazard publication with the membarrier-based asymmetric scheme, and
+ * both with QSBR readers, which publish nothing per node.
+ */
+static void
+bench_traversal(const bench_options &opt)
+{
+    static const int list_size = 1000;
+    static const struct {
+        const char *name;
+        ll_fence_t fences;
+        ll_read_mode_t read_mode;
+    } variants[] = {
+        {"symmetric", LL_FENCE_SYMMETRIC, LL_READ_HAZARD},
+        {"asymmetric", LL_FENCE_AUTO, LL_READ_HAZARD},
+        {"qsbr", LL_FENCE_AUTO, LL_READ_QSBR},
+    };
+
+    for (const auto &v : variants) {
+        for (int n : thread_counts(opt)) {
+            ll_domain_config_t config = {};
+            config.fences = v.fences;
+            config.read_mode = v.read_mode;
+            ll_domain_t *domain = ll_domain_create_ex(&config);
+            if (v.read_mode == LL_READ_HAZARD && v.fences == LL_FENCE_AUTO &&
+                !ll_domain_asymmetric_fences(domain)) {
+                ll_domain_destroy(domain);
+                break;  /* No membarrier here; the row would repeat "symmetric". */
+            }
+            ll_head_t list;
+            ll_init(&list, domain);
+
+            std::vector<int> items(list_size);
+            ll_thread_register(domain);
+            for (int &item : items)
+                ll_insert_head(&list, &item);
+            ll_thread_unregister(domain);
+
+            bench_result r = run_timed(opt, n, [&](int t, std::atomic<bool> &stop) {
+                ll_thread_register(domain);
+                uint64_t ops = 0;
+                if (t == 0 && n > 1) {
+                    for (unsigned round = 0; !stop.load(std::memory_order_relaxed); round++) {
+                        void *out = nullptr;
+                        if (ll_remove_first(&list, &out) == LL_OK)
+                            ll_insert_head(&list, out);
+                        if (round % 64 == 0)
+                            ll_reclaim(&list, nullptr);
+                        std::this_thread::yield();
+                    }
+                } else {
+                    while (!stop.load(std::memory_order_relaxed)) {
+                        ll_iterator_t iter;
+                        ll_iterator_begin(&list, &iter);
+                        while (ll_iterator_next(&iter) != nullptr)
+                            ops++;
+                        ll_iterator_end(&iter);
+                    }
+                }
+                ll_thread_unregister(domain);
+                return ops;
+            });
+            report("traversal", v.name, n, r);
+
+            ll_thread_register(domain);
+            ll_destroy(&list, nullptr);
+            ll_thread_unregister(domain);
+            ll_domain_destroy(domain);
+        }
+    }
+}
+
+/*
+ * Parallel reclaim: n threads call ll_reclaim() once each on one list of
+ * 1M nodes, half of them tombstones. The tombstones are made under an open
+ * snapshot so an untimed first pass only splits the chain into segments.
+ * Counts nodes freed; seconds is the wall time until every call returns.
+ */
+static void
+bench_reclaim(const bench_options &opt)
+{
+    static const int list_size = 1 << 20;
+
+    for (int n : thread_counts(opt)) {
+        ll_domain_t *domain = ll_domain_create(0);
+        ll_head_t list;
+        ll_init(&list, domain);
+
+        std::vector<int> items(list_size);
+        ll_thread_register(domain);
+        ll_iterator_t iter;
+        ll_iterator_begin(&list, &iter);
+        for (int i = 0; i < list_size; i++) {
+            ll_insert_head(&list, &items[i]);
+            if (i % 2)
+                ll_remove(&list, &items[i]);
+        }
+        ll_reclaim(&list, nullptr);
+        ll_iterator_end(&iter);
+
+        std::atomic<bool> start{false};
+        perf_totals perf;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < n; t++) {
+            threads.emplace_back([&]() {
+                ll_thread_register(domain);
+                while (!start.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                perf_session session;
+                ll_reclaim(&list, nullptr);
+                perf.add(session.read());
+                ll_thread_unregister(domain);
+            });
+        }
+        auto begin = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+        for (auto &t : threads)
+            t.join();
+        auto end = std::chrono::steady_clock::now();
+
+        bench_result r;
+        r.ops = list_size / 2;
+        r.seconds = std::chrono::duration<double>(end - begin).count();
+        r.perf = perf.values;
+        report("reclaim", "segments", n, r);
+
+        ll_destroy(&list, nullptr);
+        ll_thread_unregister(domain);
+        ll_domain_destroy(domain);
+    }
+}
+
+struct bench_workload {
+    const char *name;
+    void (*run)(const bench_options &);
+};
+
+static const bench_workload workloads[] = {
+    {"thread_churn", bench_thread_churn},
+    {"contention", bench_contention},
+    {"insert_burst", bench_insert_burst},
+    {"insert_latency", bench_insert_latency},
+    {"traversal", bench_traversal},
+    {"reclaim", bench_reclaim},
+};
+
+static void
+usage(const char *prog)
+{
+    std::fprintf(stderr, "usage: %s [--filter NAME] [--threads N] [--seconds S]\n", prog);
+}
+
+int
+main(int argc, char *argv[])
+{
+    bench_options opt;
+    unsigned hw = std::thread::hardware_concurrency();
+    opt.max_threads = hw > 0 ? static_cast<int>(hw) : 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            opt.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            opt.max_threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            opt.seconds = std::atof(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (opt.max_threads < 1 || opt.seconds <= 0.0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::printf("workload,variant,threads,ops,seconds,ops_per_sec,p50_ns,p99_ns,p999_ns,max_ns,"
+                "cycles_per_op,instructions_per_op,cache_refs_per_op,cache_misses_per_op,"
+                "l1d_misses_per_op,dtlb_misses_per_op\n");
+    for (const bench_workload &w : workloads) {
+        if (opt.filter && std::strstr(w.name, opt.filter) == nullptr)
+            continue;
+        w.run(opt);
+    }
+    return 0;
+}
@@ -7,25 +7,110 @@
  *   insert_txn_id < S AND (removed_txn_id == 0 OR removed_txn_id > S)
  *
  * Memory safety is ensured via hazard pointers:
- * - Each thread can protect up to HP_SLOTS_PER_THREAD pointers
+ * - Each thread has the domain's hp_slots hazard slots; list operations use
+ *   the first HP_SLOTS_INTERNAL, callers may reserve the rest
  * - Protected pointers won't be freed during reclamation
  * - Threads must register before using any list operations
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  /* syscall(), clock_gettime() under strict -std=c11 */
+#endif
+
 #include "list.h"
 
 #include <assert.h>
+#include <inttypes.h>
+#include <limits.h>
 #include <pthread.h>
+#include <sched.h>
 #include <stdalign.h>
+#include <stdarg.h>
 #include <stdatomic.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#endif
+
+/* glibc registers an rseq area per thread since 2.35; its cpu_id is a plain load. */
+#if defined(__GLIBC__) && defined(__GNUC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 35))
+#include <sys/rseq.h>
+#define LL_HAVE_RSEQ 1
+#endif
+
+/* USDT probes (SystemTap's sys/sdt.h) unless disabled with LL_NO_PROBES. */
+#if !defined(LL_NO_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define LL_HAVE_SDT 1
+#endif
+#endif
+#if defined(LL_REQUIRE_PROBES) && !defined(LL_HAVE_SDT)
+#error "LL_REQUIRE_PROBES is set but sys/sdt.h was not found"
+#endif
 
 /* ============== Internal Constants ============== */
 
-#define HP_SLOTS_PER_THREAD 2  /* prev and curr during traversal */
+#define HP_SLOTS_INTERNAL 2    /* prev and curr during traversal */
+#define HP_SLOTS_MAX 64
 #define INITIAL_HP_CAPACITY 16
+#define POP_SCAN_INTERVAL 64
+#define NODE_MARK ((uintptr_t)1) /* Set in next once a node is claimed for unlinking */
+#define NODE_PENDING ((uintptr_t)2) /* next of a wait-free insert not linked yet */
+#define RID_POPPED UINT64_MAX   /* removed_txn_id of a node whose element ll_remove_first() returned */
+#define SNAPSHOT_PENDING 1      /* active_snapshot while the real one is read; holds back all reclaim */
+#define BACKOFF_MIN_SPINS 4
+#define BACKOFF_MAX_SPINS 1024
+#define CACHE_LINE 64
+#define FC_SLOTS 64             /* Publication records per combining list */
+#define FC_PROBES 4             /* Records tried before bypassing the combiner */
+#define FC_MAX_PASSES 4         /* Passes per combining session (bounds hand-off latency) */
+#define FC_SPINS_BEFORE_YIELD 128
+#define ELIM_SLOTS 8            /* Elimination exchange slots per list */
+#define ELIM_WAIT_SPINS 256     /* How long an insert offers its element */
+#define LL_LIST_FLAGS_ALL (LL_LIST_COMBINING | LL_LIST_ELIMINATION | LL_LIST_STRIPED | \
+                           LL_LIST_PERCPU | LL_LIST_WAITFREE)
+#define STRIPES_MIN 2
+#define STRIPES_MAX 16
+#define PERCPU_MAX_BUFFERS 64   /* CPUs beyond this share buffers */
+#define PERCPU_FLUSH_NODES 64   /* A buffer this long is merged by its inserter */
+#define CONTENTION_DECAY_SHIFT 4 /* Score keeps 15/16 per insert */
+#define CONTENTION_FAIL_WEIGHT 16
+#define STRIPE_INFLATE_SCORE 128 /* ~0.5 failed head CASes per insert */
+#define STRIPE_DEFLATE_SCORE 16  /* ~1 in 16 */
+#define MARKER_TXN UINT64_MAX   /* insert_txn_id of a segment marker, never visible */
+#define SEGMENT_NODES 4096      /* Live nodes between markers placed by ll_reclaim() */
+#define SEGMENT_MARKERS_MAX 4096
+#define GENERATION_SWEEP 16     /* Every 16th ll_reclaim() also walks clean segments */
+#define HIST_SUB_BITS 3         /* 8 histogram buckets per power of two */
+#define TRACE_EVENTS_MAX (1u << 24) /* Per-thread trace ring cap */
+#define NAME_WORDS (LL_THREAD_NAME_MAX / sizeof(uint64_t))
+
+/*
+ * Static probes for bpftrace and SystemTap, provider "concurrent_ll". Each
+ * compiles to a single nop until a tracer attaches; without sys/sdt.h the
+ * arguments are not evaluated at all. Probe names and arguments are listed
+ * in the README.
+ */
+#ifdef LL_HAVE_SDT
+#define PROBE1(name, a) STAP_PROBE1(concurrent_ll, name, a)
+#define PROBE2(name, a, b) STAP_PROBE2(concurrent_ll, name, a, b)
+#define PROBE3(name, a, b, c) STAP_PROBE3(concurrent_ll, name, a, b, c)
+#else
+/* sizeof keeps probe-only locals "used" without evaluating anything. */
+#define PROBE1(name, a) ((void)sizeof(a))
+#define PROBE2(name, a, b) ((void)sizeof(a), (void)sizeof(b))
+#define PROBE3(name, a, b, c) ((void)sizeof(a), (void)sizeof(b), (void)sizeof(c))
+#endif
 
 /* ============== Internal Structures ============== */
 
@@ -35,23 +120,238 @@ typedef struct versioned_node {
     uint64_t insert_txn_id;
     _Atomic uint64_t removed_txn_id; /* 0 = not removed */
     atomic_uintptr_t next;
+    struct versioned_node *retired_next; /* Retired/orphan chain link; next stays intact for readers */
 } versioned_node_t;
 
+#ifdef LL_STATS
+/* Per-thread operation counters (see ll_stats_t), written only by the owner. */
+typedef struct thread_stats {
+    _Atomic uint64_t inserts;
+    _Atomic uint64_t removes;
+    _Atomic uint64_t remove_firsts;
+    _Atomic uint64_t lookups;
+    _Atomic uint64_t iterations;
+    _Atomic uint64_t reclaims;
+    _Atomic uint64_t insert_retries;
+    _Atomic uint64_t remove_first_retries;
+    _Atomic uint64_t nodes_visited;
+    _Atomic uint64_t nodes_skipped;
+    _Atomic uint64_t reclaim_passes;
+    _Atomic uint64_t nodes_freed;
+    _Atomic uint64_t nodes_held;
+} thread_stats_t;
+
+/*
+ * Only the owning thread writes its counters, so a relaxed load and store
+ * (a plain add) suffices; atomics just let ll_domain_stats() read them
+ * while the owner runs.
+ */
+#define STAT_ADD(state, field, n)                                             \
+    atomic_store_explicit(&(state)->stats.field,                              \
+                          atomic_load_explicit(&(state)->stats.field,          \
+                                               memory_order_relaxed) + (n),    \
+                          memory_order_relaxed)
+#else
+#define STAT_ADD(state, field, n) ((void)(n))
+#endif
+
+/* Owner-only update of a slot's retired backlog; ll_domain_health() loads it. */
+#define BACKLOG_ADJUST(state, add, sub)                                       \
+    atomic_store_explicit(&(state)->backlog,                                  \
+                          atomic_load_explicit(&(state)->backlog,              \
+                                               memory_order_relaxed) + (add) - (sub), \
+                          memory_order_relaxed)
+
+#ifdef LL_HISTOGRAMS
+/* One operation's latency counts, in ll_histogram_t's bucket layout. */
+typedef struct op_hist {
+    _Atomic uint64_t count;
+    _Atomic uint64_t sum_ns;
+    _Atomic uint64_t max_ns;
+    _Atomic uint64_t buckets[LL_HIST_BUCKETS];
+} op_hist_t;
+
+/*
+ * Per-thread latency histograms, written only by the owner. epoch trails
+ * the domain's hist_epoch until the owner's next record clears them, which
+ * is how ll_domain_histograms_reset() resets slots it cannot write.
+ */
+typedef struct thread_hist {
+    _Atomic uint64_t epoch;
+    uint64_t iter_start_ns;            /* ll_iterator_begin() time, for LL_OP_ITERATE */
+    op_hist_t ops[LL_OP_COUNT];
+} thread_hist_t;
+#endif
+
+/* Trace ring entry kinds. */
+enum { TRACE_OP, TRACE_CAS_FAIL, TRACE_RETIRE, TRACE_FREE };
+
+/*
+ * One trace event. seq is the event's index + 1, stored last, and 0 while
+ * the owner rewrites the entry, so ll_trace_dump() can read entries as
+ * they are overwritten and drop the torn ones.
+ */
+typedef struct trace_event {
+    _Atomic uint64_t seq;
+    _Atomic uint64_t ts_ns;
+    _Atomic uint64_t dur_ns;           /* TRACE_OP only */
+    _Atomic uintptr_t obj;             /* List, or node for TRACE_RETIRE */
+    _Atomic uint64_t arg;              /* ll_op_t, removed txn id, or nodes freed */
+    _Atomic uint32_t kind;
+} trace_event_t;
+
+/* Per-thread trace ring, written only by its owner. */
+typedef struct trace_ring {
+    uint64_t next;                     /* Index of the next event */
+    size_t mask;                       /* Capacity - 1 */
+    trace_event_t events[];
+} trace_ring_t;
+
 /* Per-thread state within a domain. */
 typedef struct ll_thread_state {
-    _Atomic(void *) hazard_ptrs[HP_SLOTS_PER_THREAD];
     _Atomic uint64_t active_snapshot;
     versioned_node_t *retired_list;    /* Thread-local retired nodes */
     _Atomic bool in_use;               /* Is this slot taken? */
+    size_t index;                      /* Position in the domain's threads array */
+    _Atomic uint32_t free_next;        /* Free-slot stack link (index + 1, 0 = end) */
+    struct ll_domain *domain;          /* Owning domain (NULL once destroyed) */
+    unsigned pops_since_scan;          /* ll_remove_first() calls since last retired scan */
+    versioned_node_t *spare_node;      /* Node left unused by an eliminated insert */
+    uint32_t backoff_seed;             /* xorshift state for randomized backoff */
+    uint64_t last_stamp;               /* Last LL_LIST_PERCPU insert stamp */
+    bool asym_fences;                  /* Copy of the domain's, for hp_acquire() */
+    bool qsbr;                         /* Domain uses LL_READ_QSBR */
+    _Atomic uint64_t qsbr_seen;        /* Epoch at last quiescent state (0 = offline) */
+    versioned_node_t *grace_list;      /* Retired nodes waiting out grace_epoch */
+    uint64_t grace_epoch;
+    _Atomic size_t backlog;            /* Nodes on retired_list and grace_list */
+    _Atomic size_t hazard_held;        /* Nodes the last retired scan kept for a hazard */
+    _Atomic uint64_t name[NAME_WORDS]; /* ll_thread_set_name(), NUL-padded */
+    _Atomic uint64_t snapshot_holds;   /* Tombstones reclaim left for this slot's snapshot */
+    _Atomic uint64_t hazard_holds;     /* Retired nodes scans kept for this slot's hazards */
+    unsigned hp_count;                 /* Number of hazard_ptrs (domain's hp_slots) */
+    unsigned hp_reserved;              /* First slot not reserved by the caller */
+#ifdef LL_STATS
+    thread_stats_t stats;              /* Kept across the threads that reuse this slot */
+#endif
+#ifdef LL_HISTOGRAMS
+    thread_hist_t hist;
+#endif
+    trace_ring_t *trace;               /* NULL unless the domain traces */
+    uint64_t trace_iter_start;         /* ll_iterator_begin() time, for the trace */
+    _Atomic(void *) hazard_ptrs[];     /* hp_count slots */
 } ll_thread_state_t;
 
+/*
+ * Thread arrays replaced by domain_grow(). Scanners may still be walking an
+ * old array, so it is kept until the domain is destroyed.
+ */
+typedef struct retired_array {
+    ll_thread_state_t **threads;
+    struct retired_array *next;
+} retired_array_t;
+
 /* Hazard pointer domain - manages thread state for a group of lists. */
 struct ll_domain {
-    ll_thread_state_t **threads;       /* Dynamic array of thread state pointers */
+    _Atomic(ll_thread_state_t **) threads; /* Dynamic array of thread state pointers */
     _Atomic size_t thread_count;       /* Number of allocated slots */
     _Atomic size_t capacity;           /* Current capacity */
     _Atomic(struct ll_domain *) next;  /* For global domain list (cleanup) */
-    atomic_flag resize_lock;           /* Lock for resizing threads array */
+    atomic_flag resize_lock;           /* Lock for adding slots / resizing */
+    atomic_flag reclaim_lock;          /* Serializes single-slot ll_reclaim() walks */
+    _Atomic uint64_t free_top;         /* Free-slot stack: ABA tag << 32 | (index + 1) */
+    retired_array_t *old_arrays;       /* Superseded arrays (guarded by resize_lock) */
+    _Atomic(versioned_node_t *) orphans; /* Retired nodes handed off by released slots */
+    _Atomic size_t orphan_count;       /* Nodes on orphans */
+    unsigned hp_slots;                 /* Hazard pointer slots per thread */
+    ll_backoff_t backoff;              /* CAS retry policy (LL_BACKOFF_AUTO resolves per retry) */
+    _Atomic size_t active_threads;     /* Registered threads (drives LL_BACKOFF_AUTO) */
+    bool asym_fences;                  /* Readers publish with compiler barriers only */
+    ll_read_mode_t read_mode;
+    _Atomic uint64_t qsbr_epoch;       /* Grace-period counter for LL_READ_QSBR */
+    _Atomic uint64_t hist_epoch;       /* Bumped by ll_domain_histograms_reset() */
+    size_t trace_events;               /* Trace ring capacity per thread (0 = off) */
+    bool track_blockers;               /* Charge held-back reclaim to thread slots */
+    bool track_contention;             /* Give every list heat counters */
+    pthread_mutex_t lists_lock;        /* Guards lists */
+    struct ll_list_ext *lists;         /* Lists with labels or heat counters */
+};
+
+/* Flat-combining publication record states. */
+enum { FC_EMPTY, FC_CLAIMED, FC_INSERT, FC_POP, FC_DONE };
+
+/* One flat-combining publication record, padded to its own cache line. */
+typedef struct fc_record {
+    alignas(CACHE_LINE) _Atomic int op;
+    int result;
+    void *elm;                         /* Element to insert, or popped element */
+    versioned_node_t *node;            /* Pre-allocated node for FC_INSERT */
+} fc_record_t;
+
+/* Elimination exchange slot: 0, an offered element, or ELIM_TAKEN. */
+typedef struct elim_slot {
+    alignas(CACHE_LINE) atomic_uintptr_t offer;
+} elim_slot_t;
+
+static char elim_taken_sentinel;
+#define ELIM_TAKEN ((uintptr_t)&elim_taken_sentinel)
+
+/* Insert stripe: a private head that inserts push to while a list is inflated. */
+typedef struct stripe {
+    alignas(CACHE_LINE) atomic_uintptr_t head;
+    _Atomic uint32_t pending;          /* Approximate length (LL_LIST_PERCPU) */
+} stripe_t;
+
+typedef struct stripe_set {
+    unsigned count;
+    stripe_t stripes[];
+} stripe_set_t;
+
+/*
+ * Reclaim segments of a long list. markers[i] starts segment i + 1 and
+ * segment 0 starts at the head; each runs to the next marker in the chain.
+ * claim packs a round number above the next unclaimed segment index.
+ * bounds[i] is the insert_txn_id of the node markers[i] was placed after,
+ * and garbage[i] counts tombstones believed to lie in segment i. order[]
+ * lists the published slots by ascending bound under a sequence lock, so
+ * ll_remove() finds a tombstone's generation by binary search.
+ */
+typedef struct segment_set {
+    _Atomic uint64_t claim;
+    _Atomic unsigned used;             /* High-water mark of markers[] */
+    _Atomic unsigned passes;           /* ll_reclaim() calls, for GENERATION_SWEEP */
+    _Atomic(versioned_node_t *) markers[SEGMENT_MARKERS_MAX];
+    _Atomic uint64_t bounds[SEGMENT_MARKERS_MAX];
+    _Atomic unsigned garbage[SEGMENT_MARKERS_MAX + 1];
+    atomic_flag order_lock;            /* Serializes writers of order[] */
+    _Atomic unsigned order_seq;        /* Odd while order[] is being changed */
+    _Atomic unsigned order_count;
+    _Atomic uint16_t order[SEGMENT_MARKERS_MAX]; /* Slot indexes (SEGMENT_MARKERS_MAX fits 16 bits) */
+} segment_set_t;
+
+#define MARKER_RESERVED ((versioned_node_t *)1) /* markers[] slot being filled */
+
+/* Optional per-list state, created by ll_init_ex() or on first inflation. */
+struct ll_list_ext {
+    unsigned flags;                    /* LL_LIST_* */
+    _Atomic bool striped;              /* Inserts go to stripes */
+    _Atomic uint32_t waiters;          /* Threads in ll_remove_first_wait() */
+    _Atomic uint32_t wait_seq;         /* Futex word, bumped by inserts that wake */
+    _Atomic int event_fd;              /* ll_attach_eventfd() descriptor, -1 if none */
+    _Atomic bool event_armed;          /* Next insert signals event_fd */
+    _Atomic bool draining;             /* A stripes_drain() is splicing */
+    _Atomic(stripe_set_t *) stripe_set; /* Allocated on first inflation, kept until destroy */
+    _Atomic(struct segment_set *) segments; /* Reclaim segments, once the list grows long */
+    char *labels;                      /* Copy of ll_list_config_t.labels, NULL if none */
+    ll_head_t *list;                   /* Owner, while on the domain's lists */
+    struct ll_list_ext *lists_next;    /* Next on the domain's lists (under lists_lock) */
+    bool heat;                         /* Keeps the counters below (track_contention) */
+    alignas(CACHE_LINE) _Atomic uint64_t cas_failures; /* Failed head CASes in inserts */
+    _Atomic uint32_t readers;          /* Traversals in progress */
+    _Atomic uint32_t readers_max;      /* High-water mark of readers */
+    alignas(CACHE_LINE) _Atomic bool fc_busy; /* Held by the current combiner */
+    fc_record_t fc[FC_SLOTS];
+    elim_slot_t elim[ELIM_SLOTS];
 };
 
 /*
@@ -63,9 +363,25 @@ static pthread_key_t tls_thread_state_key;
 static pthread_key_t tls_domain_key;
 static pthread_once_t tls_keys_once = PTHREAD_ONCE_INIT;
 
+/*
+ * Serializes slot teardown between ll_domain_destroy() and threads that
+ * exit (or re-register elsewhere) while still holding a slot, since either
+ * side may run first.
+ */
+static pthread_mutex_t slot_teardown_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void thread_state_abandon(ll_thread_state_t *state);
+static void segment_note_tombstone(ll_head_t *list, uint64_t insert_txn);
+
+/* Runs when a thread exits without calling ll_thread_unregister(). */
+static void tls_thread_state_destructor(void *value)
+{
+    thread_state_abandon((ll_thread_state_t *)value);
+}
+
 static void tls_keys_init(void)
 {
-    pthread_key_create(&tls_thread_state_key, NULL);
+    pthread_key_create(&tls_thread_state_key, tls_thread_state_destructor);
     pthread_key_create(&tls_domain_key, NULL);
 }
 
@@ -95,12 +411,35 @@ static inline void set_tls_domain(ll_domain_t *domain)
 
 /* ============== Helper Functions ============== */
 
+static inline void cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#endif
+}
+
 static inline versioned_node_t *ptr_unmask(uintptr_t u)
 {
-    /* Strip any mark bits (lowest bit reserved for future use). */
+    /* Strip the mark bit. */
     return (versioned_node_t *)(u & ~(uintptr_t)1UL);
 }
 
+/*
+ * Load a node's next word. A LL_LIST_WAITFREE insert publishes its node
+ * before linking it, so wait out that window (two stores wide).
+ */
+static inline uintptr_t next_load(versioned_node_t *n)
+{
+    uintptr_t v = atomic_load_explicit(&n->next, memory_order_acquire);
+    while (v == NODE_PENDING) {
+        cpu_relax();
+        v = atomic_load_explicit(&n->next, memory_order_acquire);
+    }
+    return v;
+}
+
 static inline bool node_visible(versioned_node_t *w, uint64_t snapshot)
 {
     if (!w)
@@ -116,13 +455,236 @@ static inline bool node_visible(versioned_node_t *w, uint64_t snapshot)
      * the same txn_id value. In that case, the remove is considered "after" the snapshot
      * in our MVCC model, so the node should still be visible to that snapshot.
      */
+    if (atomic_load_explicit(&w->next, memory_order_acquire) & NODE_MARK)
+        return false;  /* Claimed for unlinking. */
     return w->insert_txn_id < snapshot && (rid == 0 || rid >= snapshot);
 }
 
+static inline bool node_is_marker(const versioned_node_t *n)
+{
+    return n->insert_txn_id == MARKER_TXN;
+}
+
+static inline uint64_t monotonic_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/* ============== Backoff ============== */
+
+/* xorshift32; *seed must be non-zero. */
+static inline uint32_t next_random(uint32_t *seed)
+{
+    uint32_t x = *seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *seed = x;
+}
+
+static long online_cpus(void)
+{
+    static _Atomic long cached = 0;
+    long n = atomic_load_explicit(&cached, memory_order_relaxed);
+    if (n == 0) {
+        n = sysconf(_SC_NPROCESSORS_ONLN);
+        if (n < 1)
+            n = 1;
+        atomic_store_explicit(&cached, n, memory_order_relaxed);
+    }
+    return n;
+}
+
+/*
+ * LL_BACKOFF_AUTO: nobody to contend with when a single thread is
+ * registered, so retry immediately. Up to one thread per CPU, plain
+ * exponential pauses desynchronize the retries. When threads outnumber
+ * CPUs, randomize so preempted-and-resumed threads do not retry in lockstep.
+ */
+static ll_backoff_t backoff_resolve(ll_domain_t *domain)
+{
+    if (!domain)
+        return LL_BACKOFF_EXPONENTIAL;
+    if (domain->backoff != LL_BACKOFF_AUTO)
+        return domain->backoff;
+
+    size_t active = atomic_load_explicit(&domain->active_threads, memory_order_relaxed);
+    if (active <= 1)
+        return LL_BACKOFF_NONE;
+    return active > (size_t)online_cpus() ? LL_BACKOFF_RANDOM : LL_BACKOFF_EXPONENTIAL;
+}
+
+/* Backoff state for one retry loop. The policy is resolved on the first pause. */
+typedef struct backoff {
+    ll_domain_t *domain;
+    uint32_t *seed;             /* Per-thread seed, or NULL */
+    int policy;                 /* -1 until resolved */
+    unsigned limit;             /* Current spin ceiling */
+} backoff_t;
+
+static inline void backoff_init(backoff_t *b, ll_domain_t *domain, uint32_t *seed)
+{
+    b->domain = domain;
+    b->seed = seed;
+    b->policy = -1;
+    b->limit = BACKOFF_MIN_SPINS;
+}
+
+/* Call after a failed CAS, before retrying. */
+static void backoff_pause(backoff_t *b)
+{
+    if (b->policy < 0)
+        b->policy = (int)backoff_resolve(b->domain);
+
+    unsigned spins;
+    switch (b->policy) {
+    case LL_BACKOFF_NONE:
+        return;
+    case LL_BACKOFF_RANDOM: {
+        /* Truncated: uniform in [1, limit], limit capped at BACKOFF_MAX_SPINS. */
+        uint32_t local = (uint32_t)(uintptr_t)b | 1u;
+        spins = 1 + next_random(b->seed && *b->seed ? b->seed : &local) % b->limit;
+        break;
+    }
+    default:
+        spins = b->limit;
+        break;
+    }
+
+    for (unsigned i = 0; i < spins; i++)
+        cpu_relax();
+    if (b->limit < BACKOFF_MAX_SPINS)
+        b->limit *= 2;
+}
+
+/* ============== Asymmetric Fences ============== */
+
+/*
+ * Hazard pointers and snapshots follow a store-then-load pattern on both
+ * sides: a reader publishes, then re-reads the list; a reclaimer unlinks,
+ * then reads what readers published. Each side needs a full fence between
+ * its store and its load. With membarrier(), the reader's fence shrinks to
+ * a compiler barrier and the reclaimer's becomes a barrier IPI'd to every
+ * CPU running one of our threads, which is far rarer.
+ */
+
+#if defined(__linux__) && defined(SYS_membarrier)
+static bool membarrier_available(void)
+{
+    static _Atomic int cached = -1;
+    int v = atomic_load_explicit(&cached, memory_order_acquire);
+    if (v < 0) {
+        long cmds = syscall(SYS_membarrier, MEMBARRIER_CMD_QUERY, 0, 0);
+        v = cmds > 0 && (cmds & MEMBARRIER_CMD_PRIVATE_EXPEDITED) &&
+            syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+        atomic_store_explicit(&cached, v, memory_order_release);
+    }
+    return v;
+}
+
+static void membarrier_all(void)
+{
+    syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+}
+#else
+static bool membarrier_available(void)
+{
+    return false;
+}
+
+static void membarrier_all(void)
+{
+}
+#endif
+
+/* Reader half: between publishing and re-reading. */
+static inline void light_fence(bool asym)
+{
+    if (asym)
+        atomic_signal_fence(memory_order_seq_cst);
+    else
+        atomic_thread_fence(memory_order_seq_cst);
+}
+
+/* Reclaimer half: between unlinking and reading what readers published. */
+static void heavy_fence(const ll_domain_t *domain)
+{
+    if (domain->asym_fences)
+        membarrier_all();
+    else
+        atomic_thread_fence(memory_order_seq_cst);
+}
+
+/* ============== Quiescent States ============== */
+
+/*
+ * In LL_READ_QSBR domains a thread is quiescent wherever it holds no node
+ * from the domain. It records the epoch it saw there; a reclaimer bumps
+ * the epoch after retiring a batch and frees the batch once every online
+ * thread has recorded the bumped value (see qsbr_ready()). Loading the
+ * bumped epoch synchronizes with the unlinks before it, so the thread can
+ * no longer reach those nodes.
+ */
+
+/* Runs at the start of each list operation; a no-op inside an iterator. */
+static inline void qsbr_quiescent(ll_thread_state_t *state)
+{
+    if (!state || !state->qsbr ||
+        atomic_load_explicit(&state->active_snapshot, memory_order_relaxed) != 0)
+        return;
+    uint64_t epoch = atomic_load_explicit(&state->domain->qsbr_epoch, memory_order_acquire);
+    atomic_store_explicit(&state->qsbr_seen, epoch, memory_order_release);
+}
+
+/*
+ * Going online must be ordered before the thread's next read of a list:
+ * a reclaimer that still saw it offline (0) does not wait for it.
+ */
+static void qsbr_online(ll_thread_state_t *state, ll_domain_t *domain)
+{
+    atomic_store_explicit(&state->qsbr_seen,
+                          atomic_load_explicit(&domain->qsbr_epoch, memory_order_relaxed),
+                          memory_order_seq_cst);
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+/* Offline threads never hold up a grace period; used around blocking waits. */
+static inline bool qsbr_offline(ll_thread_state_t *state)
+{
+    if (!state->qsbr ||
+        atomic_load_explicit(&state->active_snapshot, memory_order_relaxed) != 0)
+        return false;
+    atomic_store_explicit(&state->qsbr_seen, (uint64_t)0, memory_order_release);
+    return true;
+}
+
+void ll_domain_quiescent(ll_domain_t *domain)
+{
+    if (domain && get_tls_domain() == domain)
+        qsbr_quiescent(get_tls_thread_state());
+}
+
 /* ============== Domain Management ============== */
 
 ll_domain_t *ll_domain_create(size_t initial_threads)
 {
+    ll_domain_config_t config = {0};
+    config.initial_threads = initial_threads;
+    return ll_domain_create_ex(&config);
+}
+
+ll_domain_t *ll_domain_create_ex(const ll_domain_config_t *config)
+{
+    if (!config || config->hp_slots > HP_SLOTS_MAX ||
+        config->backoff < LL_BACKOFF_AUTO || config->backoff > LL_BACKOFF_RANDOM ||
+        config->fences < LL_FENCE_AUTO || config->fences > LL_FENCE_SYMMETRIC ||
+        config->read_mode < LL_READ_HAZARD || config->read_mode > LL_READ_QSBR ||
+        config->trace_events > TRACE_EVENTS_MAX)
+        return NULL;
+
+    size_t initial_threads = config->initial_threads;
     if (initial_threads == 0)
         initial_threads = INITIAL_HP_CAPACITY;
 
@@ -130,62 +692,221 @@ ll_domain_t *ll_domain_create(size_t initial_threads)
     if (!domain)
         return NULL;
 
-    domain->threads = (ll_thread_state_t **)calloc(initial_threads,
-                                                    sizeof(ll_thread_state_t *));
-    if (!domain->threads) {
+    ll_thread_state_t **threads = (ll_thread_state_t **)calloc(
+        initial_threads, sizeof(ll_thread_state_t *));
+    if (!threads) {
         free(domain);
         return NULL;
     }
 
+    atomic_store(&domain->threads, threads);
     atomic_store(&domain->capacity, initial_threads);
     atomic_store(&domain->thread_count, 0);
+    atomic_store(&domain->free_top, (uint64_t)0);
     atomic_flag_clear(&domain->resize_lock);
+    atomic_flag_clear(&domain->reclaim_lock);
+    domain->old_arrays = NULL;
+    domain->hp_slots = config->hp_slots ? config->hp_slots : HP_SLOTS_INTERNAL;
+    domain->backoff = config->backoff;
+    atomic_store(&domain->active_threads, 0);
+    domain->asym_fences = config->fences == LL_FENCE_AUTO && membarrier_available();
+    domain->read_mode = config->read_mode;
+    atomic_store(&domain->qsbr_epoch, (uint64_t)1);
+    domain->track_blockers = config->track_blockers;
+    domain->track_contention = config->track_contention;
+    pthread_mutex_init(&domain->lists_lock, NULL);
+    domain->lists = NULL;
+    domain->trace_events = 0;
+    if (config->trace_events) {
+        domain->trace_events = 1;
+        while (domain->trace_events < config->trace_events)
+            domain->trace_events <<= 1;
+    }
 
     return domain;
 }
 
+bool ll_domain_asymmetric_fences(const ll_domain_t *domain)
+{
+    return domain && domain->asym_fences;
+}
+
+int ll_domain_stats(const ll_domain_t *domain, ll_stats_t *out)
+{
+    if (!domain || !out)
+        return LL_ERR_INVAL;
+    memset(out, 0, sizeof(*out));
+#ifdef LL_STATS
+    /* Slots are only freed by ll_domain_destroy(), so each stays readable. */
+    ll_domain_t *d = (ll_domain_t *)domain;
+    size_t count = atomic_load_explicit(&d->thread_count, memory_order_acquire);
+    ll_thread_state_t **threads = atomic_load_explicit(&d->threads, memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        thread_stats_t *st = &threads[i]->stats;
+        out->inserts += atomic_load_explicit(&st->inserts, memory_order_relaxed);
+        out->removes += atomic_load_explicit(&st->removes, memory_order_relaxed);
+        out->remove_firsts += atomic_load_explicit(&st->remove_firsts, memory_order_relaxed);
+        out->lookups += atomic_load_explicit(&st->lookups, memory_order_relaxed);
+        out->iterations += atomic_load_explicit(&st->iterations, memory_order_relaxed);
+        out->reclaims += atomic_load_explicit(&st->reclaims, memory_order_relaxed);
+        out->insert_retries += atomic_load_explicit(&st->insert_retries, memory_order_relaxed);
+        out->remove_first_retries += atomic_load_explicit(&st->remove_first_retries,
+                                                          memory_order_relaxed);
+        out->nodes_visited += atomic_load_explicit(&st->nodes_visited, memory_order_relaxed);
+        out->nodes_skipped += atomic_load_explicit(&st->nodes_skipped, memory_order_relaxed);
+        out->reclaim_passes += atomic_load_explicit(&st->reclaim_passes, memory_order_relaxed);
+        out->nodes_freed += atomic_load_explicit(&st->nodes_freed, memory_order_relaxed);
+        out->nodes_held += atomic_load_explicit(&st->nodes_held, memory_order_relaxed);
+    }
+    return LL_OK;
+#else
+    return LL_ERR_NOTSUP;
+#endif
+}
+
+int ll_domain_health(const ll_domain_t *domain, ll_domain_health_t *out,
+                     ll_thread_health_t *threads, size_t max_threads)
+{
+    if (!domain || !out || (!threads && max_threads))
+        return LL_ERR_INVAL;
+    memset(out, 0, sizeof(*out));
+    out->retired_max_slot = SIZE_MAX;
+    out->oldest_snapshot_slot = SIZE_MAX;
+
+    /* Slots are only freed by ll_domain_destroy(), so each stays readable. */
+    ll_domain_t *d = (ll_domain_t *)domain;
+    size_t count = atomic_load_explicit(&d->thread_count, memory_order_acquire);
+    ll_thread_state_t **slots = atomic_load_explicit(&d->threads, memory_order_acquire);
+    out->slots = count;
+    out->threads = atomic_load_explicit(&d->active_threads, memory_order_relaxed);
+    out->orphans = atomic_load_explicit(&d->orphan_count, memory_order_relaxed);
+    out->retired = out->orphans;
+    for (size_t i = 0; i < count; i++) {
+        ll_thread_state_t *state = slots[i];
+        uint64_t snap = atomic_load_explicit(&state->active_snapshot, memory_order_acquire);
+        size_t backlog = atomic_load_explicit(&state->backlog, memory_order_relaxed);
+        size_t held = atomic_load_explicit(&state->hazard_held, memory_order_relaxed);
+
+        out->retired += backlog;
+        out->hazard_held += held;
+        if (backlog > out->retired_max) {
+            out->retired_max = backlog;
+            out->retired_max_slot = i;
+        }
+        if (snap != 0 && (out->oldest_snapshot == 0 || snap < out->oldest_snapshot)) {
+            out->oldest_snapshot = snap;
+            out->oldest_snapshot_slot = i;
+        }
+        if (i < max_threads) {
+            threads[i].in_use = atomic_load_explicit(&state->in_use, memory_order_relaxed);
+            threads[i].active_snapshot = snap;
+            threads[i].retired = backlog;
+            threads[i].hazard_held = held;
+        }
+    }
+    return LL_OK;
+}
+
+unsigned ll_domain_hp_slots(const ll_domain_t *domain)
+{
+    return domain ? domain->hp_slots : 0;
+}
+
+/* Free a chain of retired nodes linked through next. */
+static void free_node_chain(versioned_node_t *node)
+{
+    while (node) {
+        versioned_node_t *next = node->retired_next;
+        free(node);
+        node = next;
+    }
+}
+
+static void thread_state_free(ll_thread_state_t *state)
+{
+    free(state->trace);
+    free(state);
+}
+
 void ll_domain_destroy(ll_domain_t *domain)
 {
     if (!domain)
         return;
 
-    size_t cap = atomic_load(&domain->capacity);
-    for (size_t i = 0; i < cap; i++) {
-        if (domain->threads[i]) {
-            /* Free any remaining retired nodes. */
-            versioned_node_t *node = domain->threads[i]->retired_list;
-            while (node) {
-                versioned_node_t *next = ptr_unmask(
-                    atomic_load_explicit(&node->next, memory_order_relaxed));
-                free(node);
-                node = next;
-            }
-            free(domain->threads[i]);
+    pthread_mutex_lock(&slot_teardown_lock);
+
+    ll_thread_state_t *self = get_tls_thread_state();
+    ll_thread_state_t **threads = atomic_load(&domain->threads);
+    size_t count = atomic_load(&domain->thread_count);
+    for (size_t i = 0; i < count; i++) {
+        ll_thread_state_t *state = threads[i];
+        if (!state)
+            continue;
+
+        /* Free any remaining retired nodes. */
+        free_node_chain(state->retired_list);
+        state->retired_list = NULL;
+        free_node_chain(state->grace_list);
+        state->grace_list = NULL;
+        free(state->spare_node);
+        state->spare_node = NULL;
+
+        if (state == self) {
+            set_tls_thread_state(NULL);
+            set_tls_domain(NULL);
+            thread_state_free(state);
+        } else if (atomic_load(&state->in_use)) {
+            /* Still referenced by a live thread; its exit destructor frees it. */
+            state->domain = NULL;
+        } else {
+            thread_state_free(state);
         }
     }
-    free(domain->threads);
+    free(threads);
+    free_node_chain(atomic_load(&domain->orphans));
+
+    pthread_mutex_unlock(&slot_teardown_lock);
+
+    retired_array_t *old = domain->old_arrays;
+    while (old) {
+        retired_array_t *next = old->next;
+        free(old->threads);
+        free(old);
+        old = next;
+    }
+    pthread_mutex_destroy(&domain->lists_lock);
     free(domain);
 }
 
-/* Grow the thread array if needed. Returns 0 on success. */
-static int domain_grow(ll_domain_t *domain, size_t needed)
+/* Load slot i. Callers must have observed thread_count > i. */
+static inline ll_thread_state_t *domain_slot(ll_domain_t *domain, size_t i)
 {
-    size_t cap = atomic_load_explicit(&domain->capacity, memory_order_acquire);
-    if (needed <= cap)
-        return 0;
+    ll_thread_state_t **threads = atomic_load_explicit(&domain->threads,
+                                                       memory_order_acquire);
+    return threads[i];
+}
 
-    /* Acquire resize lock. */
+static void domain_lock(ll_domain_t *domain)
+{
+    backoff_t backoff;
+    backoff_init(&backoff, domain, NULL);
     while (atomic_flag_test_and_set_explicit(&domain->resize_lock,
                                               memory_order_acquire)) {
-        /* Spin - could add backoff here. */
+        backoff_pause(&backoff);
     }
+}
 
-    /* Re-check after acquiring lock. */
-    cap = atomic_load_explicit(&domain->capacity, memory_order_acquire);
-    if (needed <= cap) {
-        atomic_flag_clear_explicit(&domain->resize_lock, memory_order_release);
+static void domain_unlock(ll_domain_t *domain)
+{
+    atomic_flag_clear_explicit(&domain->resize_lock, memory_order_release);
+}
+
+/* Grow the thread array if needed. Caller holds resize_lock. Returns 0 on success. */
+static int domain_grow(ll_domain_t *domain, size_t needed)
+{
+    size_t cap = atomic_load_explicit(&domain->capacity, memory_order_acquire);
+    if (needed <= cap)
         return 0;
-    }
 
     size_t new_cap = cap * 2;
     while (new_cap < needed)
@@ -193,565 +914,3623 @@ static int domain_grow(ll_domain_t *domain, size_t needed)
 
     ll_thread_state_t **new_threads = (ll_thread_state_t **)calloc(
         new_cap, sizeof(ll_thread_state_t *));
-    if (!new_threads) {
-        atomic_flag_clear_explicit(&domain->resize_lock, memory_order_release);
+    retired_array_t *retired = (retired_array_t *)malloc(sizeof(retired_array_t));
+    if (!new_threads || !retired) {
+        free(new_threads);
+        free(retired);
         return LL_ERR_NOMEM;
     }
 
     /* Copy existing pointers. */
-    memcpy(new_threads, domain->threads, cap * sizeof(ll_thread_state_t *));
+    ll_thread_state_t **old = atomic_load_explicit(&domain->threads,
+                                                   memory_order_relaxed);
+    memcpy(new_threads, old, cap * sizeof(ll_thread_state_t *));
 
-    ll_thread_state_t **old = domain->threads;
-    domain->threads = new_threads;
+    atomic_store_explicit(&domain->threads, new_threads, memory_order_release);
     atomic_store_explicit(&domain->capacity, new_cap, memory_order_release);
 
-    atomic_flag_clear_explicit(&domain->resize_lock, memory_order_release);
-
-    /* Free old array (safe because we only added capacity). */
-    free(old);
+    /* Readers may still hold the old array; keep it until destroy. */
+    retired->threads = old;
+    retired->next = domain->old_arrays;
+    domain->old_arrays = retired;
     return 0;
 }
 
-int ll_thread_register(ll_domain_t *domain)
+/* Pop a released slot from the free-slot stack, or NULL if empty. */
+static ll_thread_state_t *free_slot_pop(ll_domain_t *domain)
 {
-    if (!domain)
-        return LL_ERR_INVAL;
-
-    /* Already registered with this domain? */
-    if (get_tls_domain() == domain && get_tls_thread_state() != NULL)
-        return LL_OK;
+    backoff_t backoff;
+    backoff_init(&backoff, domain, NULL);
+    uint64_t top = atomic_load_explicit(&domain->free_top, memory_order_acquire);
+    for (;;) {
+        uint32_t idx = (uint32_t)top;
+        if (idx == 0)
+            return NULL;
 
-    /* Find or create a slot. */
-    size_t cap = atomic_load_explicit(&domain->capacity, memory_order_acquire);
+        /* Slots are never freed before the domain, so this read is safe. */
+        ll_thread_state_t *state = domain_slot(domain, idx - 1);
+        uint32_t next = atomic_load_explicit(&state->free_next, memory_order_relaxed);
+        uint64_t new_top = (((top >> 32) + 1) << 32) | next;
 
-    /* First, try to find an existing free slot. */
-    for (size_t i = 0; i < cap; i++) {
-        ll_thread_state_t *slot = domain->threads[i];
-        if (slot) {
-            bool expected = false;
-            if (atomic_compare_exchange_strong(&slot->in_use, &expected, true)) {
-                set_tls_thread_state(slot);
-                set_tls_domain(domain);
-                return LL_OK;
-            }
-        }
+        if (atomic_compare_exchange_weak_explicit(&domain->free_top, &top, new_top,
+                                                  memory_order_acquire,
+                                                  memory_order_acquire))
+            return state;
+        backoff_pause(&backoff);
     }
+}
 
-    /* No free slot, allocate a new one. */
-    size_t idx = atomic_fetch_add(&domain->thread_count, 1);
-    if (idx >= cap) {
-        int err = domain_grow(domain, idx + 1);
-        if (err != 0) {
-            atomic_fetch_sub(&domain->thread_count, 1);
-            return err;
-        }
+/* Push a released slot onto the free-slot stack. */
+static void free_slot_push(ll_domain_t *domain, ll_thread_state_t *state)
+{
+    backoff_t backoff;
+    backoff_init(&backoff, domain, &state->backoff_seed);
+    uint64_t top = atomic_load_explicit(&domain->free_top, memory_order_relaxed);
+    for (;;) {
+        atomic_store_explicit(&state->free_next, (uint32_t)top, memory_order_relaxed);
+        uint64_t new_top = (((top >> 32) + 1) << 32) | (uint64_t)(state->index + 1);
+        if (atomic_compare_exchange_weak_explicit(&domain->free_top, &top, new_top,
+                                                  memory_order_release,
+                                                  memory_order_relaxed))
+            break;
+        backoff_pause(&backoff);
     }
+}
 
-    ll_thread_state_t *state = (ll_thread_state_t *)calloc(1, sizeof(ll_thread_state_t));
-    if (!state) {
-        atomic_fetch_sub(&domain->thread_count, 1);
+/*
+ * Append a new slot to the domain. Slots are only ever added under
+ * resize_lock, and thread_count is published after the slot pointer, so
+ * scanners bounded by thread_count never see a half-initialized entry.
+ */
+static int domain_add_slot(ll_domain_t *domain, ll_thread_state_t **out)
+{
+    ll_thread_state_t *state = (ll_thread_state_t *)calloc(
+        1, sizeof(ll_thread_state_t) + domain->hp_slots * sizeof(_Atomic(void *)));
+    if (!state)
         return LL_ERR_NOMEM;
-    }
 
     atomic_store(&state->in_use, true);
     atomic_store(&state->active_snapshot, (uint64_t)0);
-    for (int i = 0; i < HP_SLOTS_PER_THREAD; i++)
+    state->backoff_seed = (uint32_t)(uintptr_t)state | 1u;
+    state->asym_fences = domain->asym_fences;
+    state->qsbr = domain->read_mode == LL_READ_QSBR;
+    state->hp_count = domain->hp_slots;
+    state->hp_reserved = HP_SLOTS_INTERNAL;
+    for (unsigned i = 0; i < state->hp_count; i++)
         atomic_store(&state->hazard_ptrs[i], NULL);
     state->retired_list = NULL;
+    state->domain = domain;
+    if (domain->trace_events) {
+        state->trace = (trace_ring_t *)calloc(
+            1, sizeof(trace_ring_t) + domain->trace_events * sizeof(trace_event_t));
+        if (!state->trace) {
+            free(state);
+            return LL_ERR_NOMEM;
+        }
+        state->trace->mask = domain->trace_events - 1;
+    }
 
-    domain->threads[idx] = state;
-    set_tls_thread_state(state);
-    set_tls_domain(domain);
+    domain_lock(domain);
+
+    /* Free-stack links are 32-bit, which bounds the slot count. */
+    size_t idx = atomic_load_explicit(&domain->thread_count, memory_order_relaxed);
+    int err = idx < UINT32_MAX ? domain_grow(domain, idx + 1) : LL_ERR_FULL;
+    if (err != 0) {
+        domain_unlock(domain);
+        thread_state_free(state);
+        return err;
+    }
+
+    state->index = idx;
+    atomic_load_explicit(&domain->threads, memory_order_relaxed)[idx] = state;
+    atomic_store_explicit(&domain->thread_count, idx + 1, memory_order_release);
+
+    domain_unlock(domain);
 
+    *out = state;
     return LL_OK;
 }
 
-void ll_thread_unregister(ll_domain_t *domain)
+/* Hand a chain of retired nodes to the domain for any reclaimer to free. */
+static void orphans_push(ll_domain_t *domain, versioned_node_t *chain)
 {
-    ll_thread_state_t *state = get_tls_thread_state();
-    if (!domain || get_tls_domain() != domain || !state)
+    versioned_node_t *tail = chain;
+    versioned_node_t *next;
+    size_t len = 1;
+    while ((next = tail->retired_next) != NULL) {
+        tail = next;
+        len++;
+    }
+    /* Counted before the push, so the adopter's subtraction never runs first. */
+    atomic_fetch_add_explicit(&domain->orphan_count, len, memory_order_relaxed);
+
+    backoff_t backoff;
+    backoff_init(&backoff, domain, NULL);
+    versioned_node_t *top = atomic_load_explicit(&domain->orphans, memory_order_relaxed);
+    for (;;) {
+        tail->retired_next = top;
+        if (atomic_compare_exchange_weak_explicit(&domain->orphans, &top, chain,
+                                                  memory_order_release,
+                                                  memory_order_relaxed))
+            break;
+        backoff_pause(&backoff);
+    }
+}
+
+/* Move nodes handed off by released slots onto this thread's retired list. */
+static void orphans_adopt(ll_domain_t *domain, ll_thread_state_t *state)
+{
+    versioned_node_t *chain = atomic_exchange_explicit(&domain->orphans, NULL,
+                                                       memory_order_acquire);
+    if (!chain)
         return;
 
-    /* Clear hazard pointers and snapshot. */
-    for (int i = 0; i < HP_SLOTS_PER_THREAD; i++)
+    versioned_node_t *tail = chain;
+    versioned_node_t *next;
+    size_t len = 1;
+    while ((next = tail->retired_next) != NULL) {
+        tail = next;
+        len++;
+    }
+    tail->retired_next = state->retired_list;
+    state->retired_list = chain;
+    atomic_fetch_sub_explicit(&domain->orphan_count, len, memory_order_relaxed);
+    BACKLOG_ADJUST(state, len, 0);
+}
+
+/*
+ * Return a slot to its domain: clear hazard pointers and snapshot, hand
+ * off retired nodes, and push the slot on the free-slot stack.
+ */
+static void thread_state_release(ll_thread_state_t *state)
+{
+    ll_domain_t *domain = state->domain;
+
+    for (unsigned i = 0; i < state->hp_count; i++)
         atomic_store(&state->hazard_ptrs[i], NULL);
+    state->hp_reserved = HP_SLOTS_INTERNAL;
     atomic_store(&state->active_snapshot, (uint64_t)0);
+    atomic_store(&state->qsbr_seen, (uint64_t)0);
+
+    if (state->retired_list) {
+        orphans_push(domain, state->retired_list);
+        state->retired_list = NULL;
+    }
+    if (state->grace_list) {
+        orphans_push(domain, state->grace_list);
+        state->grace_list = NULL;
+    }
+    atomic_store_explicit(&state->backlog, 0, memory_order_relaxed);
+    atomic_store_explicit(&state->hazard_held, 0, memory_order_relaxed);
+    for (size_t i = 0; i < NAME_WORDS; i++)
+        atomic_store_explicit(&state->name[i], 0, memory_order_relaxed);
+    atomic_store_explicit(&state->snapshot_holds, 0, memory_order_relaxed);
+    atomic_store_explicit(&state->hazard_holds, 0, memory_order_relaxed);
+    free(state->spare_node);
+    state->spare_node = NULL;
 
     /* Mark slot as available for reuse. */
     atomic_store(&state->in_use, false);
-
-    set_tls_thread_state(NULL);
-    set_tls_domain(NULL);
+    atomic_fetch_sub_explicit(&domain->active_threads, 1, memory_order_relaxed);
+    free_slot_push(domain, state);
 }
-/* ============== Hazard Pointer Helpers ============== */
 
-static inline void hp_acquire(ll_thread_state_t *state, int slot, void *p)
+/*
+ * Release a slot that its thread is leaving without ll_thread_unregister().
+ * The domain may already be destroyed, in which case the slot was detached
+ * and is freed here.
+ */
+static void thread_state_abandon(ll_thread_state_t *state)
 {
-    assert(state != NULL);
-    assert(slot >= 0 && slot < HP_SLOTS_PER_THREAD);
-    atomic_store_explicit(&state->hazard_ptrs[slot], p, memory_order_release);
+    pthread_mutex_lock(&slot_teardown_lock);
+    if (state->domain)
+        thread_state_release(state);
+    else
+        thread_state_free(state);
+    pthread_mutex_unlock(&slot_teardown_lock);
 }
 
-static inline void hp_release(ll_thread_state_t *state, int slot)
+int ll_thread_register(ll_domain_t *domain)
 {
-    assert(state != NULL);
-    assert(slot >= 0 && slot < HP_SLOTS_PER_THREAD);
-    atomic_store_explicit(&state->hazard_ptrs[slot], NULL, memory_order_release);
-}
+    if (!domain)
+        return LL_ERR_INVAL;
 
-static inline void hp_release_all(ll_thread_state_t *state)
-{
-    if (!state)
-        return;
-    for (int i = 0; i < HP_SLOTS_PER_THREAD; i++)
-        atomic_store_explicit(&state->hazard_ptrs[i], NULL, memory_order_release);
+    /* Already registered with this domain? */
+    ll_thread_state_t *prev = get_tls_thread_state();
+    if (get_tls_domain() == domain && prev != NULL)
+        return LL_OK;
+
+    /* Reuse a released slot if there is one; otherwise append a new slot. */
+    ll_thread_state_t *state = free_slot_pop(domain);
+    if (state) {
+        atomic_store(&state->in_use, true);
+    } else {
+        int err = domain_add_slot(domain, &state);
+        if (err != LL_OK)
+            return err;
+    }
+
+    atomic_fetch_add_explicit(&domain->active_threads, 1, memory_order_relaxed);
+    if (state->qsbr)
+        qsbr_online(state, domain);
+
+    /* A thread holds one slot at a time; give up the one in another domain. */
+    if (prev)
+        thread_state_abandon(prev);
+
+    set_tls_thread_state(state);
+    set_tls_domain(domain);
+
+    return LL_OK;
 }
 
-/* Check if any thread in the domain has a hazard pointer to p. */
-static bool any_hp_equals(ll_domain_t *domain, void *p)
+void ll_thread_unregister(ll_domain_t *domain)
 {
-    if (!domain)
-        return false;
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (!domain || get_tls_domain() != domain || !state)
+        return;
 
-    size_t count = atomic_load_explicit(&domain->thread_count, memory_order_acquire);
-    for (size_t i = 0; i < count; i++) {
-        ll_thread_state_t *state = domain->threads[i];
-        if (!state)
+    thread_state_release(state);
+
+    set_tls_thread_state(NULL);
+    set_tls_domain(NULL);
+}
+/* ============== Thread Names and Reclaim Blockers ============== */
+
+/* Copy a slot's name out; torn only if its thread renames meanwhile. */
+static void slot_name_load(ll_thread_state_t *state, char out[LL_THREAD_NAME_MAX])
+{
+    for (size_t i = 0; i < NAME_WORDS; i++) {
+        uint64_t w = atomic_load_explicit(&state->name[i], memory_order_relaxed);
+        memcpy(out + i * sizeof(w), &w, sizeof(w));
+    }
+    out[LL_THREAD_NAME_MAX - 1] = '\0';
+}
+
+int ll_thread_set_name(ll_domain_t *domain, const char *name)
+{
+    if (!domain || !name)
+        return LL_ERR_INVAL;
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (get_tls_domain() != domain || !state)
+        return LL_ERR_NOTHREAD;
+
+    char buf[LL_THREAD_NAME_MAX] = {0};
+    strncpy(buf, name, LL_THREAD_NAME_MAX - 1);
+    for (size_t i = 0; i < NAME_WORDS; i++) {
+        uint64_t w;
+        memcpy(&w, buf + i * sizeof(w), sizeof(w));
+        atomic_store_explicit(&state->name[i], w, memory_order_relaxed);
+    }
+    return LL_OK;
+}
+
+int ll_domain_top_blockers(const ll_domain_t *domain, ll_blocker_t *out, size_t k)
+{
+    if (!domain || (!out && k))
+        return LL_ERR_INVAL;
+
+    ll_domain_t *d = (ll_domain_t *)domain;
+    size_t count = atomic_load_explicit(&d->thread_count, memory_order_acquire);
+    size_t found = 0;
+    for (size_t i = 0; i < count && k; i++) {
+        ll_thread_state_t *state = domain_slot(d, i);
+        ll_blocker_t b;
+        b.snapshot_holds = atomic_load_explicit(&state->snapshot_holds, memory_order_relaxed);
+        b.hazard_holds = atomic_load_explicit(&state->hazard_holds, memory_order_relaxed);
+        uint64_t total = b.snapshot_holds + b.hazard_holds;
+        if (total == 0)
             continue;
-        for (int j = 0; j < HP_SLOTS_PER_THREAD; j++) {
-            if (atomic_load_explicit(&state->hazard_ptrs[j], memory_order_acquire) == p)
-                return true;
-        }
+
+        /* Insertion into out[], kept sorted by total, heaviest first. */
+        size_t pos = found < k ? found : k;
+        while (pos > 0 && out[pos - 1].snapshot_holds + out[pos - 1].hazard_holds < total)
+            pos--;
+        if (pos == k)
+            continue;
+        b.slot = i;
+        b.active_snapshot = atomic_load_explicit(&state->active_snapshot, memory_order_relaxed);
+        slot_name_load(state, b.name);
+        size_t last = found < k ? found : k - 1;
+        memmove(&out[pos + 1], &out[pos], (last - pos) * sizeof(*out));
+        out[pos] = b;
+        if (found < k)
+            found++;
     }
-    return false;
+    return (int)found;
 }
 
-/* Find the minimum active snapshot version across all threads. */
-static uint64_t min_active_snapshot(ll_domain_t *domain)
+int ll_domain_blockers_reset(ll_domain_t *domain)
 {
     if (!domain)
-        return UINT64_MAX;
-
-    uint64_t min = UINT64_MAX;
+        return LL_ERR_INVAL;
     size_t count = atomic_load_explicit(&domain->thread_count, memory_order_acquire);
     for (size_t i = 0; i < count; i++) {
-        ll_thread_state_t *state = domain->threads[i];
-        if (!state)
-            continue;
-        uint64_t v = atomic_load_explicit(&state->active_snapshot, memory_order_acquire);
-        if (v != 0 && v < min)
-            min = v;
+        ll_thread_state_t *state = domain_slot(domain, i);
+        atomic_store_explicit(&state->snapshot_holds, 0, memory_order_relaxed);
+        atomic_store_explicit(&state->hazard_holds, 0, memory_order_relaxed);
     }
-    return min;
+    return LL_OK;
 }
 
-/* ============== List Lifecycle ============== */
+/* ============== Latency Histograms ============== */
 
-int ll_init(ll_head_t *list, ll_domain_t *domain)
+/*
+ * Buckets are log-linear: values below 8 ns get one bucket each, then
+ * every power of two is split into 8 equal buckets, so a bucket's width is
+ * at most 1/8 of its lower bound. The last bucket also takes everything
+ * from 2^34 ns (about 17 s) up.
+ */
+/* Smallest value that lands in bucket b. */
+static uint64_t hist_bucket_floor(unsigned b)
 {
-    if (!list || !domain)
-        return LL_ERR_INVAL;
+    if (b < (1u << HIST_SUB_BITS))
+        return b;
+    unsigned e = (b >> HIST_SUB_BITS) + HIST_SUB_BITS - 1;
+    uint64_t sub = b & ((1u << HIST_SUB_BITS) - 1);
+    return ((1ull << HIST_SUB_BITS) + sub) << (e - HIST_SUB_BITS);
+}
 
-    atomic_store_explicit(&list->head, (uintptr_t)0, memory_order_release);
-    atomic_store_explicit(&list->commit_id, 1, memory_order_release);
-    list->domain = domain;
+void ll_histogram_merge(ll_histogram_t *dst, const ll_histogram_t *src)
+{
+    if (!dst || !src)
+        return;
+    dst->count += src->count;
+    dst->sum_ns += src->sum_ns;
+    if (src->max_ns > dst->max_ns)
+        dst->max_ns = src->max_ns;
+    for (unsigned b = 0; b < LL_HIST_BUCKETS; b++)
+        dst->buckets[b] += src->buckets[b];
+}
 
-    return LL_OK;
+uint64_t ll_histogram_percentile(const ll_histogram_t *h, double pct)
+{
+    if (!h || h->count == 0)
+        return 0;
+    if (pct >= 100.0)
+        return h->max_ns;
+    /* Nearest rank: the smallest sample with at least pct% at or below it. */
+    double exact = pct / 100.0 * (double)h->count;
+    uint64_t rank = (uint64_t)exact;
+    if ((double)rank < exact || rank == 0)
+        rank++;
+    uint64_t seen = 0;
+    for (unsigned b = 0; b < LL_HIST_BUCKETS; b++) {
+        seen += h->buckets[b];
+        if (seen >= rank) {
+            /* Report the bucket's upper edge, capped by the largest sample. */
+            uint64_t edge = b + 1 < LL_HIST_BUCKETS ? hist_bucket_floor(b + 1) - 1 : h->max_ns;
+            return edge < h->max_ns ? edge : h->max_ns;
+        }
+    }
+    return h->max_ns;
 }
 
-void ll_destroy(ll_head_t *list, void (*free_cb)(void *))
+#ifdef LL_HISTOGRAMS
+static unsigned hist_bucket(uint64_t ns)
 {
-    if (!list)
-        return;
+    if (ns < (1u << HIST_SUB_BITS))
+        return (unsigned)ns;
+    unsigned e = 63u - (unsigned)__builtin_clzll(ns);
+    unsigned b = ((e - HIST_SUB_BITS + 1) << HIST_SUB_BITS) +
+                 (unsigned)((ns >> (e - HIST_SUB_BITS)) & ((1u << HIST_SUB_BITS) - 1));
+    return b < LL_HIST_BUCKETS ? b : LL_HIST_BUCKETS - 1;
+}
 
-    /* Free all nodes (assumes no concurrent access). */
-    versioned_node_t *curr = ptr_unmask(
-        atomic_load_explicit(&list->head, memory_order_acquire));
-    while (curr) {
-        versioned_node_t *next = ptr_unmask(
-            atomic_load_explicit(&curr->next, memory_order_acquire));
-        if (free_cb)
-            free_cb(curr->user_elm);
-        free(curr);
-        curr = next;
+/* Add one sample of op, which started at start_ns, to the caller's slot. */
+static void hist_record(ll_op_t op, uint64_t start_ns)
+{
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (!state || !state->domain)
+        return;
+    uint64_t ns = monotonic_ns() - start_ns;
+    thread_hist_t *th = &state->hist;
+
+    uint64_t epoch = atomic_load_explicit(&state->domain->hist_epoch, memory_order_relaxed);
+    if (atomic_load_explicit(&th->epoch, memory_order_relaxed) != epoch) {
+        for (unsigned i = 0; i < LL_OP_COUNT; i++) {
+            op_hist_t *h = &th->ops[i];
+            atomic_store_explicit(&h->count, 0, memory_order_relaxed);
+            atomic_store_explicit(&h->sum_ns, 0, memory_order_relaxed);
+            atomic_store_explicit(&h->max_ns, 0, memory_order_relaxed);
+            for (unsigned b = 0; b < LL_HIST_BUCKETS; b++)
+                atomic_store_explicit(&h->buckets[b], 0, memory_order_relaxed);
+        }
+        /* Readers only trust a slot once its epoch says it was cleared. */
+        atomic_store_explicit(&th->epoch, epoch, memory_order_release);
     }
-    atomic_store_explicit(&list->head, (uintptr_t)0, memory_order_release);
+
+    /* Owner-only, like STAT_ADD(): plain adds behind relaxed atomics. */
+    op_hist_t *h = &th->ops[op];
+    _Atomic uint64_t *bucket = &h->buckets[hist_bucket(ns)];
+    atomic_store_explicit(bucket, atomic_load_explicit(bucket, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+    atomic_store_explicit(&h->count, atomic_load_explicit(&h->count, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+    atomic_store_explicit(&h->sum_ns, atomic_load_explicit(&h->sum_ns, memory_order_relaxed) + ns,
+                          memory_order_relaxed);
+    if (ns > atomic_load_explicit(&h->max_ns, memory_order_relaxed))
+        atomic_store_explicit(&h->max_ns, ns, memory_order_relaxed);
 }
 
-/* ============== Insert Operations ============== */
+#define HIST_BEGIN() uint64_t hist_start = monotonic_ns()
+#define HIST_END(op) hist_record((op), hist_start)
+#else
+#define HIST_BEGIN() ((void)0)
+#define HIST_END(op) ((void)0)
+#endif
 
-int ll_insert_head(ll_head_t *list, void *elm)
+int ll_domain_histograms(const ll_domain_t *domain, ll_histogram_t out[LL_OP_COUNT])
 {
-    if (!list || !elm)
+    if (!domain || !out)
         return LL_ERR_INVAL;
-    if (!get_tls_thread_state())
-        return LL_ERR_NOTHREAD;
+    memset(out, 0, LL_OP_COUNT * sizeof(ll_histogram_t));
+#ifdef LL_HISTOGRAMS
+    ll_domain_t *d = (ll_domain_t *)domain;
+    uint64_t epoch = atomic_load_explicit(&d->hist_epoch, memory_order_relaxed);
+    size_t count = atomic_load_explicit(&d->thread_count, memory_order_acquire);
+    ll_thread_state_t **threads = atomic_load_explicit(&d->threads, memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        thread_hist_t *th = &threads[i]->hist;
+        if (atomic_load_explicit(&th->epoch, memory_order_acquire) != epoch)
+            continue;  /* Nothing recorded since the last reset. */
+        for (unsigned op = 0; op < LL_OP_COUNT; op++) {
+            op_hist_t *h = &th->ops[op];
+            ll_histogram_t *o = &out[op];
+            o->count += atomic_load_explicit(&h->count, memory_order_relaxed);
+            o->sum_ns += atomic_load_explicit(&h->sum_ns, memory_order_relaxed);
+            uint64_t max = atomic_load_explicit(&h->max_ns, memory_order_relaxed);
+            if (max > o->max_ns)
+                o->max_ns = max;
+            for (unsigned b = 0; b < LL_HIST_BUCKETS; b++)
+                o->buckets[b] += atomic_load_explicit(&h->buckets[b], memory_order_relaxed);
+        }
+    }
+    return LL_OK;
+#else
+    return LL_ERR_NOTSUP;
+#endif
+}
 
-    /* Allocate wrapper node. */
-    versioned_node_t *w = (versioned_node_t *)aligned_alloc(
-        alignof(versioned_node_t), sizeof(versioned_node_t));
-    if (!w)
-        return LL_ERR_NOMEM;
+int ll_domain_histograms_reset(ll_domain_t *domain)
+{
+    if (!domain)
+        return LL_ERR_INVAL;
+#ifdef LL_HISTOGRAMS
+    atomic_fetch_add_explicit(&domain->hist_epoch, 1, memory_order_relaxed);
+    return LL_OK;
+#else
+    return LL_ERR_NOTSUP;
+#endif
+}
 
-    /* Get transaction ID AFTER allocation succeeds. */
-    uint64_t txn_id = atomic_fetch_add_explicit(&list->commit_id, 1,
-                                                 memory_order_acq_rel);
+/* ============== Tracing ============== */
 
-    w->user_elm = elm;
-    w->insert_txn_id = txn_id;
-    atomic_store_explicit(&w->removed_txn_id, (uint64_t)0, memory_order_release);
+static const char *const op_names[LL_OP_COUNT] = {
+    "insert", "remove", "remove_first", "iterate", "reclaim"
+};
 
-    /* CAS loop to insert at head. */
-    uintptr_t old_head;
-    do {
-        old_head = atomic_load_explicit(&list->head, memory_order_acquire);
-        atomic_store_explicit(&w->next, old_head, memory_order_release);
-    } while (!atomic_compare_exchange_weak_explicit(
-        &list->head, &old_head, (uintptr_t)w,
-        memory_order_release, memory_order_acquire));
+/* Append an event to the owner's ring, overwriting the oldest. */
+static void trace_emit(trace_ring_t *ring, uint32_t kind, uint64_t ts_ns,
+                       uint64_t dur_ns, const void *obj, uint64_t arg)
+{
+    uint64_t idx = ring->next++;
+    trace_event_t *e = &ring->events[idx & ring->mask];
+
+    /* Seqlock write: readers that see any new field also see seq == 0. */
+    atomic_store_explicit(&e->seq, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&e->ts_ns, ts_ns, memory_order_relaxed);
+    atomic_store_explicit(&e->dur_ns, dur_ns, memory_order_relaxed);
+    atomic_store_explicit(&e->obj, (uintptr_t)obj, memory_order_relaxed);
+    atomic_store_explicit(&e->arg, arg, memory_order_relaxed);
+    atomic_store_explicit(&e->kind, kind, memory_order_relaxed);
+    atomic_store_explicit(&e->seq, idx + 1, memory_order_release);
+}
 
-    return LL_OK;
+static inline void trace_note(ll_thread_state_t *state, uint32_t kind,
+                              const void *obj, uint64_t arg)
+{
+    if (state->trace)
+        trace_emit(state->trace, kind, monotonic_ns(), 0, obj, arg);
 }
-/* ============== Remove Operations ============== */
 
-int ll_remove(ll_head_t *list, void *elm)
+/* Start time of a public operation, or 0 if the caller is not tracing. */
+static inline uint64_t trace_op_begin(void)
 {
-    if (!list || !elm)
-        return LL_ERR_INVAL;
     ll_thread_state_t *state = get_tls_thread_state();
-    if (!state)
-        return LL_ERR_NOTHREAD;
+    return state && state->trace ? monotonic_ns() : 0;
+}
 
-    /* Get transaction ID for the remove. */
-    uint64_t txn_id = atomic_fetch_add_explicit(&list->commit_id, 1,
-                                                 memory_order_acq_rel);
+static void trace_op_end(ll_op_t op, const void *list, uint64_t start_ns)
+{
+    if (!start_ns)
+        return;
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (state && state->trace)
+        trace_emit(state->trace, TRACE_OP, start_ns, monotonic_ns() - start_ns, list, op);
+}
 
-    /* Traverse with hazard pointer protection. */
-    versioned_node_t *curr = ptr_unmask(
-        atomic_load_explicit(&list->head, memory_order_acquire));
+/* Write s escaped for the inside of a JSON string. */
+static void json_put_chars(FILE *out, const char *s)
+{
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\')
+            fprintf(out, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(out, "\\u%04x", c);
+        else
+            fputc(c, out);
+    }
+}
 
-    while (curr) {
-        hp_acquire(state, 0, curr);
+/* Print one event in Chrome trace-event format. */
+static int trace_print(FILE *out, long pid, size_t tid, uint32_t kind, uint64_t ts_ns,
+                       uint64_t dur_ns, uintptr_t obj, uint64_t arg)
+{
+    double ts = (double)ts_ns / 1000.0;
+    switch (kind) {
+    case TRACE_OP:
+        return fprintf(out, ",\n{\"name\":\"%s\",\"cat\":\"op\",\"ph\":\"X\","
+                       "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%ld,\"tid\":%zu,"
+                       "\"args\":{\"list\":\"%#" PRIxPTR "\"}}",
+                       arg < LL_OP_COUNT ? op_names[arg] : "op", ts,
+                       (double)dur_ns / 1000.0, pid, tid, obj);
+    case TRACE_CAS_FAIL:
+        return fprintf(out, ",\n{\"name\":\"cas_retry\",\"cat\":\"contention\",\"ph\":\"i\","
+                       "\"s\":\"t\",\"ts\":%.3f,\"pid\":%ld,\"tid\":%zu,"
+                       "\"args\":{\"list\":\"%#" PRIxPTR "\",\"op\":\"%s\"}}",
+                       ts, pid, tid, obj, arg < LL_OP_COUNT ? op_names[arg] : "op");
+    case TRACE_RETIRE:
+        return fprintf(out, ",\n{\"name\":\"retire\",\"cat\":\"reclaim\",\"ph\":\"i\","
+                       "\"s\":\"t\",\"ts\":%.3f,\"pid\":%ld,\"tid\":%zu,"
+                       "\"args\":{\"node\":\"%#" PRIxPTR "\",\"removed_txn\":%" PRIu64 "}}",
+                       ts, pid, tid, obj, arg);
+    default:
+        return fprintf(out, ",\n{\"name\":\"free\",\"cat\":\"reclaim\",\"ph\":\"i\","
+                       "\"s\":\"t\",\"ts\":%.3f,\"pid\":%ld,\"tid\":%zu,"
+                       "\"args\":{\"nodes\":%" PRIu64 "}}",
+                       ts, pid, tid, arg);
+    }
+}
 
-        /* Re-validate pointer. */
-        versioned_node_t *check = ptr_unmask(
-            atomic_load_explicit(&list->head, memory_order_acquire));
+int ll_trace_dump(const ll_domain_t *domain, FILE *out)
+{
+    if (!domain || !out)
+        return LL_ERR_INVAL;
 
-        /* Find curr in the list (it may have moved). */
-        bool found_curr = false;
-        versioned_node_t *scan = check;
-        while (scan) {
-            if (scan == curr) {
-                found_curr = true;
-                break;
-            }
-            scan = ptr_unmask(atomic_load_explicit(&scan->next, memory_order_acquire));
-        }
+    ll_domain_t *d = (ll_domain_t *)domain;
+    long pid = (long)getpid();
+    /* A process_name record first, so every event can follow with a comma. */
+    fprintf(out, "{\"traceEvents\":[\n{\"name\":\"process_name\",\"ph\":\"M\","
+            "\"pid\":%ld,\"args\":{\"name\":\"concurrent_ll\"}}", pid);
 
-        if (!found_curr) {
-            /* Node was removed, restart. */
-            hp_release(state, 0);
-            curr = ptr_unmask(atomic_load_explicit(&list->head, memory_order_acquire));
+    size_t count = atomic_load_explicit(&d->thread_count, memory_order_acquire);
+    ll_thread_state_t **threads = atomic_load_explicit(&d->threads, memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        trace_ring_t *ring = threads[i]->trace;
+        if (!ring)
             continue;
+        char name[LL_THREAD_NAME_MAX];
+        slot_name_load(threads[i], name);
+        fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%ld,"
+                "\"tid\":%zu,\"args\":{\"name\":\"", pid, i);
+        if (name[0]) {
+            json_put_chars(out, name);
+            fprintf(out, " (slot %zu)\"}}", i);
+        } else {
+            fprintf(out, "slot %zu\"}}", i);
         }
 
-        if (curr->user_elm == elm) {
-            atomic_store_explicit(&curr->removed_txn_id, txn_id, memory_order_release);
-            hp_release(state, 0);
-            return LL_OK;
+        for (size_t k = 0; k <= ring->mask; k++) {
+            trace_event_t *e = &ring->events[k];
+            uint64_t seq = atomic_load_explicit(&e->seq, memory_order_acquire);
+            if (seq == 0)
+                continue;  /* Never written, or being rewritten */
+            uint64_t ts_ns = atomic_load_explicit(&e->ts_ns, memory_order_relaxed);
+            uint64_t dur_ns = atomic_load_explicit(&e->dur_ns, memory_order_relaxed);
+            uintptr_t obj = atomic_load_explicit(&e->obj, memory_order_relaxed);
+            uint64_t arg = atomic_load_explicit(&e->arg, memory_order_relaxed);
+            uint32_t kind = atomic_load_explicit(&e->kind, memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&e->seq, memory_order_relaxed) != seq)
+                continue;  /* Overwritten while we read it */
+            trace_print(out, pid, i, kind, ts_ns, dur_ns, obj, arg);
         }
-
-        versioned_node_t *next = ptr_unmask(
-            atomic_load_explicit(&curr->next, memory_order_acquire));
-        hp_release(state, 0);
-        curr = next;
     }
 
-    return LL_ERR_NOTFOUND;
+    fputs("\n]}\n", out);
+    return ferror(out) ? LL_ERR_INVAL : LL_OK;
 }
 
-int ll_remove_first(ll_head_t *list, void **out_elm)
-{
-    if (!list || !out_elm)
-        return LL_ERR_INVAL;
-    ll_thread_state_t *state = get_tls_thread_state();
-    if (!state)
-        return LL_ERR_NOTHREAD;
-    uint64_t snapshot = atomic_load_explicit(&list->commit_id, memory_order_acquire);
+/* ============== Prometheus Export ============== */
 
-    for (;;) {
-        uintptr_t head_val = atomic_load_explicit(&list->head, memory_order_acquire);
-        versioned_node_t *w = ptr_unmask(head_val);
-        if (!w)
-            return LL_ERR_NOTFOUND;
+/* snprintf()-style sink: counts every byte, stores what fits. */
+typedef struct prom_writer {
+    char *buf;
+    size_t len;
+    size_t pos;
+} prom_writer_t;
 
-        hp_acquire(state, 0, w);
+static void prom_printf(prom_writer_t *w, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
 
-        /* Verify head hasn't changed. */
-        if (atomic_load_explicit(&list->head, memory_order_acquire) != head_val) {
-            hp_release(state, 0);
-            continue;
-        }
+static void prom_printf(prom_writer_t *w, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    bool room = w->pos < w->len;
+    int n = vsnprintf(room ? w->buf + w->pos : NULL, room ? w->len - w->pos : 0, fmt, ap);
+    va_end(ap);
+    if (n > 0)
+        w->pos += (size_t)n;
+}
 
-        if (node_visible(w, snapshot)) {
-            uintptr_t next_val = atomic_load_explicit(&w->next, memory_order_acquire);
-            if (atomic_compare_exchange_weak_explicit(
-                    &list->head, &head_val, next_val,
-                    memory_order_release, memory_order_acquire)) {
-                *out_elm = w->user_elm;
-                hp_release(state, 0);
-                free(w);
-                return LL_OK;
-            }
-            hp_release(state, 0);
-            continue;
-        }
+/* HELP and TYPE lines, which precede a metric family's samples. */
+static void prom_family(prom_writer_t *w, const char *name, const char *type,
+                        const char *help)
+{
+    prom_printf(w, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
 
-        /* Head not visible, search for first visible node. */
-        versioned_node_t *prev = w;
-        versioned_node_t *curr = ptr_unmask(
-            atomic_load_explicit(&w->next, memory_order_acquire));
-        bool cas_failed = false;
+static void prom_gauge(prom_writer_t *w, const char *name, const char *help,
+                       uint64_t value)
+{
+    prom_family(w, name, "gauge", help);
+    prom_printf(w, "%s %" PRIu64 "\n", name, value);
+}
 
-        while (curr) {
-            hp_acquire(state, 1, curr);
+#ifdef LL_STATS
+static void prom_counter(prom_writer_t *w, const char *name, const char *help,
+                         uint64_t value)
+{
+    prom_family(w, name, "counter", help);
+    prom_printf(w, "%s %" PRIu64 "\n", name, value);
+}
+#endif
 
-            if (node_visible(curr, snapshot)) {
-                uintptr_t next_val = atomic_load_explicit(&curr->next, memory_order_acquire);
-                uintptr_t prev_next = (uintptr_t)curr;
+#ifdef LL_HISTOGRAMS
+/*
+ * Prometheus buckets are cumulative and inclusive, with fixed upper
+ * bounds, so the log-linear buckets are folded at powers of two: 2^e ns
+ * starts bucket (e - 2) * 8, and every bucket before it holds samples of
+ * at most 2^e - 1 ns, which is the le bound. 2^33 is the last power below
+ * the catch-all final bucket.
+ */
+#define PROM_HIST_EXP_MIN 4
+#define PROM_HIST_EXP_MAX 33
 
-                if (atomic_compare_exchange_weak_explicit(
-                        &prev->next, &prev_next, next_val,
-                        memory_order_release, memory_order_acquire)) {
-                    *out_elm = curr->user_elm;
-                    hp_release_all(state);
-                    free(curr);
-                    return LL_OK;
-                }
-                cas_failed = true;
+static void prom_histograms(prom_writer_t *w, const ll_histogram_t hist[LL_OP_COUNT])
+{
+    prom_family(w, "ll_operation_duration_seconds", "histogram",
+                "Latency of list operations.");
+    for (unsigned op = 0; op < LL_OP_COUNT; op++) {
+        const ll_histogram_t *h = &hist[op];
+        uint64_t cumulative = 0;
+        unsigned b = 0;
+        for (unsigned e = PROM_HIST_EXP_MIN; e <= PROM_HIST_EXP_MAX; e++) {
+            for (; b < (e - 2) << HIST_SUB_BITS; b++)
+                cumulative += h->buckets[b];
+            prom_printf(w, "ll_operation_duration_seconds_bucket{op=\"%s\",le=\"%.9g\"} %"
+                        PRIu64 "\n", op_names[op], (double)(((uint64_t)1 << e) - 1) / 1e9,
+                        cumulative);
+        }
+        prom_printf(w, "ll_operation_duration_seconds_bucket{op=\"%s\",le=\"+Inf\"} %"
+                    PRIu64 "\n", op_names[op], h->count);
+        prom_printf(w, "ll_operation_duration_seconds_sum{op=\"%s\"} %.9f\n",
+                    op_names[op], (double)h->sum_ns / 1e9);
+        prom_printf(w, "ll_operation_duration_seconds_count{op=\"%s\"} %" PRIu64 "\n",
+                    op_names[op], h->count);
+    }
+}
+#endif
+
+/* Per-list series of labeled lists, one family at a time. Caller holds lists_lock. */
+static void prom_lists(prom_writer_t *w, ll_domain_t *domain)
+{
+    static const struct {
+        const char *name, *type, *help;
+        bool heat;                     /* Only lists with heat counters */
+    } families[] = {
+        { "ll_list_commits_total", "counter", "Transactions committed on the list.", false },
+        { "ll_list_contention", "gauge", "Decaying head CAS failure score.", false },
+        { "ll_list_stripes", "gauge", "Insert stripes in use (0 = not inflated).", false },
+        { "ll_list_waiters", "gauge", "Threads blocked in ll_remove_first_wait().", false },
+        { "ll_list_cas_failures_total", "counter", "Failed head CASes in inserts.", true },
+        { "ll_list_readers_max", "gauge", "Most traversals in progress at once.", true },
+    };
+
+    for (size_t f = 0; f < sizeof(families) / sizeof(families[0]); f++) {
+        bool header = false;
+        for (struct ll_list_ext *ext = domain->lists; ext; ext = ext->lists_next) {
+            if (!ext->labels || (families[f].heat && !ext->heat))
+                continue;
+            if (!header) {
+                prom_family(w, families[f].name, families[f].type, families[f].help);
+                header = true;
+            }
+            ll_head_t *list = ext->list;
+            uint64_t value;
+            switch (f) {
+            case 0:
+                value = atomic_load_explicit(&list->commit_id, memory_order_acquire) - 1;
+                break;
+            case 1:
+                value = atomic_load_explicit(&list->contention, memory_order_relaxed);
+                break;
+            case 2:
+                value = ll_list_stripes(list);
+                break;
+            case 3:
+                value = atomic_load_explicit(&ext->waiters, memory_order_relaxed);
+                break;
+            case 4:
+                value = atomic_load_explicit(&ext->cas_failures, memory_order_relaxed);
+                break;
+            default:
+                value = atomic_load_explicit(&ext->readers_max, memory_order_relaxed);
                 break;
             }
-
-            prev = curr;
-            curr = ptr_unmask(atomic_load_explicit(&curr->next, memory_order_acquire));
+            prom_printf(w, "%s{%s} %" PRIu64 "\n", families[f].name, ext->labels, value);
         }
-
-        hp_release_all(state);
-        if (cas_failed)
-            continue;
-        return LL_ERR_NOTFOUND;
     }
 }
 
-/* ============== Iterator & Traversal ============== */
-
-int ll_iterator_begin(ll_head_t *list, ll_iterator_t *iter)
+int ll_stats_format_prometheus(const ll_domain_t *domain, char *buf, size_t len)
 {
-    if (!list || !iter)
+    if (!domain || (!buf && len))
         return LL_ERR_INVAL;
-    ll_thread_state_t *state = get_tls_thread_state();
-    if (!state)
-        return LL_ERR_NOTHREAD;
+    ll_domain_t *d = (ll_domain_t *)domain;
+    prom_writer_t w = { buf, len, 0 };
+
+    ll_domain_health_t health;
+    ll_domain_health(domain, &health, NULL, 0);
+    prom_gauge(&w, "ll_threads", "Threads registered with the domain.", health.threads);
+    prom_gauge(&w, "ll_thread_slots", "Thread slots, registered or free.", health.slots);
+    prom_gauge(&w, "ll_retired_nodes", "Retired nodes not yet freed, orphans included.",
+               health.retired);
+    prom_gauge(&w, "ll_orphaned_nodes", "Retired nodes handed off by departed threads.",
+               health.orphans);
+    prom_gauge(&w, "ll_hazard_held_nodes", "Retired nodes the last scans kept for hazards.",
+               health.hazard_held);
+
+#ifdef LL_STATS
+    ll_stats_t st;
+    ll_domain_stats(domain, &st);
+    prom_family(&w, "ll_operations_total", "counter", "List operations by type.");
+    prom_printf(&w, "ll_operations_total{op=\"insert\"} %" PRIu64 "\n", st.inserts);
+    prom_printf(&w, "ll_operations_total{op=\"remove\"} %" PRIu64 "\n", st.removes);
+    prom_printf(&w, "ll_operations_total{op=\"remove_first\"} %" PRIu64 "\n", st.remove_firsts);
+    prom_printf(&w, "ll_operations_total{op=\"lookup\"} %" PRIu64 "\n", st.lookups);
+    prom_printf(&w, "ll_operations_total{op=\"iterate\"} %" PRIu64 "\n", st.iterations);
+    prom_printf(&w, "ll_operations_total{op=\"reclaim\"} %" PRIu64 "\n", st.reclaims);
+    prom_counter(&w, "ll_insert_retries_total", "Failed head CASes in ll_insert_head().",
+                 st.insert_retries);
+    prom_counter(&w, "ll_remove_first_retries_total", "Restarted walks in ll_remove_first().",
+                 st.remove_first_retries);
+    prom_counter(&w, "ll_nodes_visited_total", "Nodes walked by lookups and iterators.",
+                 st.nodes_visited);
+    prom_counter(&w, "ll_nodes_skipped_total", "Visited nodes not visible at their snapshot.",
+                 st.nodes_skipped);
+    prom_counter(&w, "ll_reclaim_passes_total", "Scans of a thread's retired nodes.",
+                 st.reclaim_passes);
+    prom_counter(&w, "ll_nodes_freed_total", "Retired nodes freed by scans.", st.nodes_freed);
+    prom_counter(&w, "ll_nodes_held_total", "Retired nodes a scan kept for a hazard pointer.",
+                 st.nodes_held);
+#endif
+
+#ifdef LL_HISTOGRAMS
+    ll_histogram_t *hist = (ll_histogram_t *)malloc(LL_OP_COUNT * sizeof(ll_histogram_t));
+    if (hist) {
+        ll_domain_histograms(domain, hist);
+        prom_histograms(&w, hist);
+        free(hist);
+    }
+#endif
 
-    iter->list = list;
-    iter->snapshot = atomic_load_explicit(&list->commit_id, memory_order_acquire);
-    iter->current_node = NULL;
+    pthread_mutex_lock(&d->lists_lock);
+    prom_lists(&w, d);
+    pthread_mutex_unlock(&d->lists_lock);
 
-    /* Register active snapshot. */
-    atomic_store_explicit(&state->active_snapshot, iter->snapshot,
-                          memory_order_release);
+    return w.pos > INT_MAX ? INT_MAX : (int)w.pos;
+}
 
-    return LL_OK;
+/* ============== Hazard Pointer Helpers ============== */
+
+static inline void hp_acquire(ll_thread_state_t *state, int slot, void *p)
+{
+    assert(state != NULL);
+    assert(slot >= 0 && (unsigned)slot < state->hp_count);
+    /*
+     * Release keeps reads of the node this slot protected until now ahead
+     * of the overwrite; the fence orders the store before re-validation.
+     */
+    atomic_store_explicit(&state->hazard_ptrs[slot], p, memory_order_release);
+    light_fence(state->asym_fences);
 }
 
-void *ll_iterator_next(ll_iterator_t *iter)
+static inline void hp_release(ll_thread_state_t *state, int slot)
 {
-    ll_thread_state_t *state = get_tls_thread_state();
-    if (!iter || !iter->list || !state)
-        return NULL;
+    assert(state != NULL);
+    assert(slot >= 0 && (unsigned)slot < state->hp_count);
+    atomic_store_explicit(&state->hazard_ptrs[slot], NULL, memory_order_release);
+}
 
-    versioned_node_t *curr;
+/* Release the slots used by list operations; caller-reserved slots are kept. */
+static inline void hp_release_all(ll_thread_state_t *state)
+{
+    if (!state)
+        return;
+    unsigned n = state->hp_count < HP_SLOTS_INTERNAL ? state->hp_count : HP_SLOTS_INTERNAL;
+    for (unsigned i = 0; i < n; i++)
+        atomic_store_explicit(&state->hazard_ptrs[i], NULL, memory_order_release);
+}
 
-    if (iter->current_node == NULL) {
-        /* First call - start from head. */
-        curr = ptr_unmask(atomic_load_explicit(&iter->list->head, memory_order_acquire));
-    } else {
-        /* Continue from after current node. */
-        curr = ptr_unmask(atomic_load_explicit(
-            &((versioned_node_t *)iter->current_node)->next, memory_order_acquire));
+/* Check if any thread in the domain has a hazard pointer to p. */
+static bool any_hp_equals(ll_domain_t *domain, const void *p)
+{
+    if (!domain)
+        return false;
+
+    size_t count = atomic_load_explicit(&domain->thread_count, memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        ll_thread_state_t *state = domain_slot(domain, i);
+        if (!state)
+            continue;
+        for (unsigned j = 0; j < state->hp_count; j++) {
+            if (atomic_load_explicit(&state->hazard_ptrs[j], memory_order_acquire) == p)
+                return true;
+        }
+    }
+    return false;
+}
+
+/* Charge a node a retired scan kept to the first slot whose hazard holds it. */
+static void blocker_note_hazard(ll_domain_t *domain, versioned_node_t *n)
+{
+    size_t count = atomic_load_explicit(&domain->thread_count, memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        ll_thread_state_t *state = domain_slot(domain, i);
+        for (unsigned j = 0; j < state->hp_count; j++) {
+            void *p = atomic_load_explicit(&state->hazard_ptrs[j], memory_order_acquire);
+            if (p == n || p == n->user_elm) {
+                atomic_fetch_add_explicit(&state->hazard_holds, 1, memory_order_relaxed);
+                return;
+            }
+        }
+    }
+}
+
+/*
+ * Sorted copy of every published hazard pointer. Retire scans take one
+ * copy and binary-search it per node instead of rescanning every slot of
+ * every thread for each retired node.
+ */
+typedef struct hazard_set {
+    void **ptrs;
+    size_t count;
+} hazard_set_t;
+
+static int hazard_ptr_cmp(const void *a, const void *b)
+{
+    uintptr_t x = (uintptr_t)*(void *const *)a;
+    uintptr_t y = (uintptr_t)*(void *const *)b;
+    return (x > y) - (x < y);
+}
+
+/* Returns false if the copy could not be allocated. */
+static bool hazard_set_collect(ll_domain_t *domain, hazard_set_t *set)
+{
+    size_t count = atomic_load_explicit(&domain->thread_count, memory_order_acquire);
+    set->count = 0;
+    set->ptrs = (void **)malloc((count * domain->hp_slots + 1) * sizeof(void *));
+    if (!set->ptrs)
+        return false;
+
+    for (size_t i = 0; i < count; i++) {
+        ll_thread_state_t *state = domain_slot(domain, i);
+        if (!state)
+            continue;
+        for (unsigned j = 0; j < state->hp_count; j++) {
+            void *p = atomic_load_explicit(&state->hazard_ptrs[j], memory_order_acquire);
+            if (p)
+                set->ptrs[set->count++] = p;
+        }
+    }
+    qsort(set->ptrs, set->count, sizeof(void *), hazard_ptr_cmp);
+    return true;
+}
+
+static bool hazard_set_contains(const hazard_set_t *set, const void *p)
+{
+    return p && bsearch(&p, set->ptrs, set->count, sizeof(void *), hazard_ptr_cmp) != NULL;
+}
+
+/* True once every online thread has been quiescent at or after epoch. */
+static bool qsbr_elapsed(ll_domain_t *domain, ll_thread_state_t *self, uint64_t epoch)
+{
+    /* Pairs with the fence in qsbr_online(). */
+    atomic_thread_fence(memory_order_seq_cst);
+
+    bool self_quiescent = atomic_load_explicit(&self->active_snapshot,
+                                               memory_order_relaxed) == 0;
+    size_t count = atomic_load_explicit(&domain->thread_count, memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        ll_thread_state_t *state = domain_slot(domain, i);
+        if (state == self && self_quiescent)
+            continue;
+        uint64_t seen = atomic_load_explicit(&state->qsbr_seen, memory_order_acquire);
+        if (seen != 0 && seen < epoch)
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Take the retired nodes whose grace period has elapsed. Each thread keeps
+ * one batch in its grace period at a time; nodes retired meanwhile start
+ * the next one once that batch is released.
+ */
+static versioned_node_t *qsbr_ready(ll_domain_t *domain, ll_thread_state_t *state)
+{
+    versioned_node_t *ready = NULL;
+    if (state->grace_list && qsbr_elapsed(domain, state, state->grace_epoch)) {
+        ready = state->grace_list;
+        state->grace_list = NULL;
+    }
+    if (!state->grace_list && state->retired_list) {
+        state->grace_list = state->retired_list;
+        state->retired_list = NULL;
+        state->grace_epoch = atomic_fetch_add_explicit(&domain->qsbr_epoch, 1,
+                                                       memory_order_seq_cst) + 1;
+        /* Often true at once, e.g. when no other thread is online. */
+        if (qsbr_elapsed(domain, state, state->grace_epoch)) {
+            versioned_node_t **tail = &ready;
+            while (*tail)
+                tail = &(*tail)->retired_next;
+            *tail = state->grace_list;
+            state->grace_list = NULL;
+        }
+    }
+    return ready;
+}
+
+/*
+ * Free retired nodes (including any handed off by released slots) that no
+ * hazard pointer protects. A caller-published pointer to either the node
+ * or its user element holds the node back. Elements of popped nodes belong
+ * to whoever popped them and never reach free_cb; with popped_only set,
+ * other nodes are kept for a later scan that has their callback. QSBR
+ * domains only consider nodes whose grace period has elapsed.
+ */
+static size_t retired_scan(ll_domain_t *domain, ll_thread_state_t *state,
+                           void (*free_cb)(void *), bool popped_only)
+{
+    orphans_adopt(domain, state);
+
+    versioned_node_t *pending;
+    if (state->qsbr) {
+        pending = qsbr_ready(domain, state);
+    } else {
+        pending = state->retired_list;
+        state->retired_list = NULL;
+    }
+    if (!pending)
+        return 0;
+
+    /* Order the unlinks that retired these nodes before reading hazards. */
+    heavy_fence(domain);
+
+    hazard_set_t set;
+    bool batched = hazard_set_collect(domain, &set);
+    uint64_t freed = 0, held_back = 0;
+
+    while (pending) {
+        versioned_node_t *n = pending;
+        pending = n->retired_next;
+
+        bool popped = atomic_load_explicit(&n->removed_txn_id,
+                                           memory_order_relaxed) == RID_POPPED;
+        bool held = (popped_only && !popped) || (batched
+            ? hazard_set_contains(&set, n) || hazard_set_contains(&set, n->user_elm)
+            : any_hp_equals(domain, n) || any_hp_equals(domain, n->user_elm));
+        if (held) {
+            n->retired_next = state->retired_list;
+            state->retired_list = n;
+            held_back += !(popped_only && !popped);
+            if (domain->track_blockers && !(popped_only && !popped))
+                blocker_note_hazard(domain, n);
+        } else {
+            void *user = n->user_elm;
+            PROBE3(node_free, n, user, popped);
+            free(n);
+            if (free_cb && !popped)
+                free_cb(user);
+            freed++;
+        }
+    }
+
+    if (batched)
+        free(set.ptrs);
+    STAT_ADD(state, reclaim_passes, 1);
+    STAT_ADD(state, nodes_freed, freed);
+    STAT_ADD(state, nodes_held, held_back);
+    BACKLOG_ADJUST(state, 0, (size_t)freed);
+    atomic_store_explicit(&state->hazard_held, (size_t)held_back, memory_order_relaxed);
+    if (freed)
+        trace_note(state, TRACE_FREE, NULL, freed);
+    return (size_t)freed;
+}
+
+static inline void retire_node(ll_thread_state_t *state, versioned_node_t *n)
+{
+    PROBE3(node_retire, n, n->insert_txn_id,
+           atomic_load_explicit(&n->removed_txn_id, memory_order_relaxed));
+    trace_note(state, TRACE_RETIRE, n,
+               atomic_load_explicit(&n->removed_txn_id, memory_order_relaxed));
+    n->retired_next = state->retired_list;
+    state->retired_list = n;
+    BACKLOG_ADJUST(state, 1, 0);
+}
+
+/*
+ * Nodes popped by ll_remove_first() are freed by a scan every
+ * POP_SCAN_INTERVAL pops, so pop-only workloads do not depend on
+ * ll_reclaim() to release memory.
+ */
+static void pop_scan_tick(ll_domain_t *domain, ll_thread_state_t *state)
+{
+    if (++state->pops_since_scan >= POP_SCAN_INTERVAL) {
+        state->pops_since_scan = 0;
+        retired_scan(domain, state, NULL, true);
+    }
+}
+
+/*
+ * Swing link from a marked node to its successor. Exactly one thread
+ * succeeds and must retire the node.
+ */
+static inline bool unlink_node(atomic_uintptr_t *link, versioned_node_t *node,
+                               uintptr_t next_val)
+{
+    uintptr_t expected = (uintptr_t)node;
+    return atomic_compare_exchange_strong_explicit(link, &expected,
+                                                   next_val & ~NODE_MARK,
+                                                   memory_order_release,
+                                                   memory_order_relaxed);
+}
+
+/*
+ * Elimination: an insert whose head CAS failed offers its element in a
+ * random slot for a while; a remove_first whose CAS failed takes any
+ * offered element. The pair linearizes as the insert immediately followed
+ * by the pop, so neither touches the list.
+ */
+
+/* Returns true if a remover took elm. */
+static bool elim_offer(struct ll_list_ext *ext, ll_thread_state_t *state, void *elm)
+{
+    elim_slot_t *slot = &ext->elim[next_random(&state->backoff_seed) % ELIM_SLOTS];
+    uintptr_t expected = 0;
+    if (!atomic_compare_exchange_strong_explicit(&slot->offer, &expected, (uintptr_t)elm,
+                                                 memory_order_release,
+                                                 memory_order_relaxed))
+        return false;
+
+    for (unsigned i = 0; i < ELIM_WAIT_SPINS; i++) {
+        if (atomic_load_explicit(&slot->offer, memory_order_relaxed) == ELIM_TAKEN)
+            break;
+        cpu_relax();
+    }
+
+    expected = (uintptr_t)elm;
+    if (atomic_compare_exchange_strong_explicit(&slot->offer, &expected, 0,
+                                                memory_order_acquire,
+                                                memory_order_acquire))
+        return false;  /* Withdrawn unclaimed. */
+
+    /* Taken; the offering thread clears its own slot. */
+    atomic_store_explicit(&slot->offer, 0, memory_order_release);
+    return true;
+}
+
+static bool elim_take(struct ll_list_ext *ext, ll_thread_state_t *state, void **out_elm)
+{
+    size_t start = next_random(&state->backoff_seed) % ELIM_SLOTS;
+    for (size_t i = 0; i < ELIM_SLOTS; i++) {
+        elim_slot_t *slot = &ext->elim[(start + i) % ELIM_SLOTS];
+        uintptr_t v = atomic_load_explicit(&slot->offer, memory_order_acquire);
+        if (v != 0 && v != ELIM_TAKEN &&
+            atomic_compare_exchange_strong_explicit(&slot->offer, &v, ELIM_TAKEN,
+                                                    memory_order_acq_rel,
+                                                    memory_order_relaxed)) {
+            *out_elm = (void *)v;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Pop the first node visible at snapshot. A node is claimed by setting
+ * NODE_MARK in its next pointer: a marked node's next can no longer change,
+ * so unlinking it cannot drop a concurrent unlink of its successor. Any
+ * thread that meets a marked node helps unlink it. Hazard slots 0 and 1
+ * alternate between prev and curr. With elim set, a failed attempt first
+ * tries to take an element offered by a concurrent insert.
+ */
+static int list_pop_first(atomic_uintptr_t *head, uint64_t snapshot,
+                          ll_domain_t *domain, ll_thread_state_t *state,
+                          struct ll_list_ext *elim, void **out_elm)
+{
+    backoff_t backoff;
+    backoff_init(&backoff, domain, &state->backoff_seed);
+    unsigned retries = 0;
+
+    for (;;) {
+        atomic_uintptr_t *link = head;
+        versioned_node_t *curr = ptr_unmask(atomic_load_explicit(head, memory_order_acquire));
+        int slot = 0;
+        bool retry = false;
+
+        while (curr) {
+            hp_acquire(state, slot, curr);
+
+            /* curr is only safe to touch if its predecessor still links to it. */
+            if (atomic_load_explicit(link, memory_order_acquire) != (uintptr_t)curr) {
+                retry = true;
+                break;
+            }
+
+            uintptr_t next_val = next_load(curr);
+            if (next_val & NODE_MARK) {
+                if (unlink_node(link, curr, next_val))
+                    retire_node(state, curr);
+                retry = true;
+                break;
+            }
+
+            if (node_visible(curr, snapshot)) {
+                if (!atomic_compare_exchange_strong_explicit(
+                        &curr->next, &next_val, next_val | NODE_MARK,
+                        memory_order_acq_rel, memory_order_acquire)) {
+                    retry = true;
+                    break;
+                }
+                *out_elm = curr->user_elm;
+                /* Still hazard-protected, so no scan can free it before this lands. */
+                atomic_store_explicit(&curr->removed_txn_id, RID_POPPED, memory_order_relaxed);
+                if (unlink_node(link, curr, next_val))
+                    retire_node(state, curr);
+                hp_release_all(state);
+                pop_scan_tick(domain, state);
+                return LL_OK;
+            }
+
+            link = &curr->next;
+            slot ^= 1;
+            curr = ptr_unmask(next_val);
+        }
+
+        hp_release_all(state);
+        if (!retry)
+            return LL_ERR_NOTFOUND;
+        retries++;
+        STAT_ADD(state, remove_first_retries, 1);
+        PROBE3(cas_retry, head, LL_OP_REMOVE_FIRST, retries);
+        trace_note(state, TRACE_CAS_FAIL, head, LL_OP_REMOVE_FIRST);
+        if (elim && elim_take(elim, state, out_elm))
+            return LL_OK;
+        backoff_pause(&backoff);
+    }
+}
+
+/*
+ * Unlink and retire nodes removed before min_snap, along with any a pop
+ * claimed but could not unlink itself.
+ */
+static void reclaim_unlink(atomic_uintptr_t *head, uint64_t min_snap,
+                           ll_thread_state_t *state)
+{
+    atomic_uintptr_t *link = head;
+    versioned_node_t *curr = ptr_unmask(atomic_load_explicit(head, memory_order_acquire));
+
+    while (curr) {
+        uint64_t rid = atomic_load_explicit(&curr->removed_txn_id, memory_order_acquire);
+        uintptr_t next_val = next_load(curr);
+        bool reclaimable = (next_val & NODE_MARK) || (rid != 0 && rid < min_snap);
+
+        if (reclaimable) {
+            hp_acquire(state, 0, curr);
+            if ((next_val & NODE_MARK) ||
+                atomic_compare_exchange_strong_explicit(
+                    &curr->next, &next_val, next_val | NODE_MARK,
+                    memory_order_acq_rel, memory_order_acquire)) {
+                if (unlink_node(link, curr, next_val)) {
+                    hp_release(state, 0);
+                    retire_node(state, curr);
+                    curr = ptr_unmask(next_val);
+                    continue;
+                }
+            }
+            hp_release(state, 0);
+        }
+
+        link = &curr->next;
+        curr = ptr_unmask(next_val);
+    }
+}
+
+/*
+ * Find the minimum active snapshot version across all threads, and the
+ * slot holding it (SIZE_MAX if none) in *holder if non-NULL.
+ */
+static uint64_t min_active_snapshot(ll_domain_t *domain, size_t *holder)
+{
+    if (holder)
+        *holder = SIZE_MAX;
+    if (!domain)
+        return UINT64_MAX;
+
+    uint64_t min = UINT64_MAX;
+    size_t count = atomic_load_explicit(&domain->thread_count, memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        ll_thread_state_t *state = domain_slot(domain, i);
+        if (!state)
+            continue;
+        uint64_t v = atomic_load_explicit(&state->active_snapshot, memory_order_acquire);
+        if (v != 0 && v < min) {
+            min = v;
+            if (holder)
+                *holder = i;
+        }
+    }
+    return min;
+}
+
+/*
+ * Publish a snapshot of commit_id for this thread and return it. A
+ * placeholder goes up first: a reclaimer that misses it read commit_id
+ * before our read below, so its horizon cannot pass our snapshot.
+ */
+static uint64_t snapshot_publish(ll_thread_state_t *state, ll_commit_id_t *commit_id)
+{
+    atomic_store_explicit(&state->active_snapshot, (uint64_t)SNAPSHOT_PENDING,
+                          memory_order_relaxed);
+    light_fence(state->asym_fences);
+    uint64_t snapshot = atomic_load_explicit(commit_id, memory_order_acquire);
+    atomic_store_explicit(&state->active_snapshot, snapshot, memory_order_release);
+    return snapshot;
+}
+
+/*
+ * Oldest snapshot reclamation must preserve for a list with this commit_id.
+ * *holder (if non-NULL) gets the slot whose snapshot set it, or SIZE_MAX.
+ */
+static uint64_t reclaim_horizon(ll_domain_t *domain, ll_commit_id_t *commit_id,
+                                size_t *holder)
+{
+    uint64_t now = atomic_load_explicit(commit_id, memory_order_acquire);
+    heavy_fence(domain);
+    size_t slot;
+    uint64_t min = min_active_snapshot(domain, &slot);
+    if (holder)
+        *holder = min < now ? slot : SIZE_MAX;
+    return min < now ? min : now;
+}
+
+/* ============== Per-List Extensions ============== */
+
+static struct ll_list_ext *ext_alloc(unsigned flags)
+{
+    struct ll_list_ext *ext = (struct ll_list_ext *)aligned_alloc(
+        alignof(struct ll_list_ext), sizeof(struct ll_list_ext));
+    if (!ext)
+        return NULL;
+    ext->flags = flags;
+    atomic_init(&ext->striped, false);
+    atomic_init(&ext->waiters, 0);
+    atomic_init(&ext->wait_seq, 0);
+    atomic_init(&ext->event_fd, -1);
+    atomic_init(&ext->event_armed, false);
+    atomic_init(&ext->draining, false);
+    atomic_init(&ext->stripe_set, NULL);
+    atomic_init(&ext->segments, NULL);
+    ext->labels = NULL;
+    ext->list = NULL;
+    ext->lists_next = NULL;
+    ext->heat = false;
+    atomic_init(&ext->cas_failures, (uint64_t)0);
+    atomic_init(&ext->readers, 0);
+    atomic_init(&ext->readers_max, 0);
+    atomic_init(&ext->fc_busy, false);
+    for (size_t i = 0; i < FC_SLOTS; i++)
+        atomic_init(&ext->fc[i].op, FC_EMPTY);
+    for (size_t i = 0; i < ELIM_SLOTS; i++)
+        atomic_init(&ext->elim[i].offer, (uintptr_t)0);
+    return ext;
+}
+
+/* Get the list's extension state, creating a flag-less one if needed. */
+static struct ll_list_ext *ext_get_or_create(ll_head_t *list)
+{
+    struct ll_list_ext *ext = atomic_load_explicit(&list->ext, memory_order_acquire);
+    if (ext)
+        return ext;
+
+    struct ll_list_ext *fresh = ext_alloc(0);
+    if (!fresh)
+        return NULL;
+    if (atomic_compare_exchange_strong_explicit(&list->ext, &ext, fresh,
+                                                memory_order_acq_rel,
+                                                memory_order_acquire))
+        return fresh;
+    free(fresh);
+    return ext;
+}
+
+/*
+ * Insert striping. Every head insert feeds a decaying score of failed head
+ * CASes kept in the list head. Past STRIPE_INFLATE_SCORE the list inflates:
+ * inserts push onto one of several padded stripe heads, picked by thread
+ * slot, instead of the shared head. Every other operation first drains the
+ * stripes into the main chain (newest first) and then proceeds as usual, so
+ * the set of nodes visible to a snapshot is unchanged. Stripe failures are
+ * scaled by the stripe count, estimating what the single head would see;
+ * once that falls to STRIPE_DEFLATE_SCORE the list deflates.
+ *
+ * LL_LIST_PERCPU lists stay inflated with one buffer per CPU, and their
+ * inserts skip commit_id as well: a buffered node carries a per-thread
+ * monotonic clock stamp, and the drain that merges it assigns the real
+ * insert_txn_id. Until then no snapshot can see it, exactly as if the
+ * insert had not happened yet.
+ */
+
+static bool stripes_inflate(ll_head_t *list)
+{
+    struct ll_list_ext *ext = ext_get_or_create(list);
+    if (!ext)
+        return false;
+
+    if (!atomic_load_explicit(&ext->stripe_set, memory_order_acquire)) {
+        long cpus = online_cpus();
+        unsigned count;
+        if (ext->flags & LL_LIST_PERCPU)
+            count = cpus < 1 ? 1 : cpus > PERCPU_MAX_BUFFERS ? PERCPU_MAX_BUFFERS
+                                                             : (unsigned)cpus;
+        else
+            count = cpus < STRIPES_MIN ? STRIPES_MIN
+                  : cpus > STRIPES_MAX ? STRIPES_MAX : (unsigned)cpus;
+        size_t size = sizeof(stripe_set_t) + count * sizeof(stripe_t);
+        size = (size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+        stripe_set_t *set = (stripe_set_t *)aligned_alloc(CACHE_LINE, size);
+        if (!set)
+            return false;
+        set->count = count;
+        for (unsigned i = 0; i < count; i++) {
+            atomic_init(&set->stripes[i].head, (uintptr_t)0);
+            atomic_init(&set->stripes[i].pending, 0);
+        }
+
+        stripe_set_t *expected = NULL;
+        if (!atomic_compare_exchange_strong_explicit(&ext->stripe_set, &expected, set,
+                                                     memory_order_acq_rel,
+                                                     memory_order_acquire))
+            free(set);
+    }
+    atomic_store_explicit(&ext->striped, true, memory_order_release);
+    return true;
+}
+
+/* Private chain helpers for stripes_drain(). */
+static inline versioned_node_t *chain_next(versioned_node_t *n)
+{
+    return ptr_unmask(atomic_load_explicit(&n->next, memory_order_relaxed));
+}
+
+static inline void chain_link(versioned_node_t *n, versioned_node_t *next)
+{
+    atomic_store_explicit(&n->next, (uintptr_t)next, memory_order_relaxed);
+}
+
+/* Merge two chains sorted by insert_txn_id, highest first. */
+static versioned_node_t *chain_merge(versioned_node_t *a, versioned_node_t *b)
+{
+    versioned_node_t *first = NULL;
+    versioned_node_t *tail = NULL;
+    while (a && b) {
+        versioned_node_t **pick = a->insert_txn_id >= b->insert_txn_id ? &a : &b;
+        versioned_node_t *n = *pick;
+        *pick = chain_next(n);
+        if (tail)
+            chain_link(tail, n);
+        else
+            first = n;
+        tail = n;
+    }
+    if (tail)
+        chain_link(tail, a ? a : b);
+    else
+        first = a ? a : b;
+    return first;
+}
+
+static bool chain_sorted(versioned_node_t *head)
+{
+    for (versioned_node_t *n = head, *next; n && (next = chain_next(n)); n = next) {
+        if (n->insert_txn_id < next->insert_txn_id)
+            return false;
+    }
+    return true;
+}
+
+/* Merge sort a NULL-terminated chain by insert_txn_id, highest first. */
+static versioned_node_t *chain_sort(versioned_node_t *head)
+{
+    if (!head || !chain_next(head))
+        return head;
+
+    versioned_node_t *slow = head;
+    for (versioned_node_t *fast = chain_next(head); fast && chain_next(fast);
+         fast = chain_next(chain_next(fast)))
+        slow = chain_next(slow);
+    versioned_node_t *b = chain_next(slow);
+    chain_link(slow, NULL);
+    return chain_merge(chain_sort(head), chain_sort(b));
+}
+
+/* Wait for a concurrent drain to finish splicing. */
+static void drain_wait(struct ll_list_ext *ext)
+{
+    for (unsigned spins = 0; atomic_load_explicit(&ext->draining, memory_order_seq_cst);
+         spins++) {
+        if (spins < BACKOFF_MAX_SPINS)
+            cpu_relax();
+        else
+            sched_yield();
+    }
+}
+
+/*
+ * Move everything pushed onto stripes into the main chain. Stripe chains
+ * are merged by insert_txn_id (or stamp) so the newest nodes end up
+ * nearest the head. Drains are serialized, so a caller that finds the
+ * stripes empty while another drain holds their nodes waits for the
+ * splice; on return every insert that finished before the call is in the
+ * main chain.
+ */
+static void stripes_drain(ll_head_t *list)
+{
+    struct ll_list_ext *ext = atomic_load_explicit(&list->ext, memory_order_acquire);
+    if (!ext)
+        return;
+    stripe_set_t *set = atomic_load_explicit(&ext->stripe_set, memory_order_acquire);
+    if (!set)
+        return;
+
+    for (;;) {
+        bool pending = false;
+        for (unsigned i = 0; i < set->count && !pending; i++)
+            pending = atomic_load_explicit(&set->stripes[i].head, memory_order_seq_cst) != 0;
+        if (!pending) {
+            drain_wait(ext);
+            return;
+        }
+        if (!atomic_exchange_explicit(&ext->draining, true, memory_order_seq_cst))
+            break;
+        drain_wait(ext);
+    }
+
+    /*
+     * Taken chains are private until spliced. Push order within a stripe
+     * can differ from txn (or stamp) order when threads share it, so sort
+     * any chain that is out of order before merging them all.
+     */
+    versioned_node_t *chains[PERCPU_MAX_BUFFERS];
+    size_t k = 0;
+    for (unsigned i = 0; i < set->count; i++) {
+        if (!atomic_load_explicit(&set->stripes[i].head, memory_order_relaxed))
+            continue;
+        atomic_store_explicit(&set->stripes[i].pending, 0, memory_order_relaxed);
+        versioned_node_t *chain = (versioned_node_t *)atomic_exchange_explicit(
+            &set->stripes[i].head, (uintptr_t)0, memory_order_seq_cst);
+        if (chain)
+            chains[k++] = chain_sorted(chain) ? chain : chain_sort(chain);
+    }
+    if (k == 0) {
+        atomic_store_explicit(&ext->draining, false, memory_order_release);
+        return;
+    }
+    for (size_t step = 1; step < k; step *= 2) {
+        for (size_t i = 0; i + step < k; i += 2 * step)
+            chains[i] = chain_merge(chains[i], chains[i + step]);
+    }
+
+    versioned_node_t *first = chains[0];
+    versioned_node_t *last;
+    size_t n = 1;
+    for (last = first; chain_next(last); last = chain_next(last))
+        n++;
+
+    /* Stamped nodes get their txn ids now, newest highest. */
+    if (ext->flags & LL_LIST_PERCPU) {
+        uint64_t txn = atomic_fetch_add_explicit(&list->commit_id, n,
+                                                 memory_order_seq_cst) + n;
+        for (versioned_node_t *node = first; node; node = chain_next(node))
+            node->insert_txn_id = --txn;
+    }
+
+    uintptr_t old_head = atomic_load_explicit(&list->head, memory_order_acquire);
+    for (;;) {
+        atomic_store_explicit(&last->next, old_head, memory_order_release);
+        if (atomic_compare_exchange_weak_explicit(
+                &list->head, &old_head, (uintptr_t)first,
+                memory_order_release, memory_order_acquire))
+            break;
+    }
+    atomic_store_explicit(&ext->draining, false, memory_order_release);
+}
+
+/* CPU the caller runs on, or -1 if the kernel will not say. */
+static inline int current_cpu(void)
+{
+#ifdef LL_HAVE_RSEQ
+    if (__rseq_size > 0) {
+        const struct rseq *rs = (const struct rseq *)(
+            (char *)__builtin_thread_pointer() + __rseq_offset);
+        int cpu = (int)atomic_load_explicit((_Atomic uint32_t *)&rs->cpu_id,
+                                            memory_order_relaxed);
+        if (cpu >= 0)
+            return cpu;
+    }
+#endif
+#ifdef __linux__
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__i386__))
+/*
+ * True if the kernel keeps time with the TSC, which it only does once it
+ * has found the counters synchronized across CPUs.
+ */
+static bool tsc_is_clocksource(void)
+{
+    static _Atomic int cached = -1;
+    int v = atomic_load_explicit(&cached, memory_order_relaxed);
+    if (v < 0) {
+        char name[16] = {0};
+        FILE *f = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+        v = f && fgets(name, sizeof(name), f) && strncmp(name, "tsc\n", 4) == 0;
+        if (f)
+            fclose(f);
+        atomic_store_explicit(&cached, v, memory_order_relaxed);
+    }
+    return v;
+}
+#endif
+
+/*
+ * Order stamp for a buffered LL_LIST_PERCPU insert: a clock that is
+ * consistent across CPUs, bumped past the thread's previous stamp so a
+ * thread's own inserts keep their order even if it migrates between
+ * buffers. rdtscp waits for earlier loads, so an insert that happens after
+ * another also stamps after it.
+ */
+static uint64_t insert_stamp(ll_thread_state_t *state)
+{
+    uint64_t stamp;
+#if defined(__linux__) && (defined(__x86_64__) || defined(__i386__))
+    unsigned aux;
+    if (tsc_is_clocksource()) {
+        stamp = __builtin_ia32_rdtscp(&aux);
+    } else
+#endif
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        stamp = (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+    }
+    if (stamp <= state->last_stamp)
+        stamp = state->last_stamp + 1;
+    state->last_stamp = stamp;
+    return stamp;
+}
+
+/* Fold one insert's failed CAS count into the list's contention score. */
+static void contention_note(ll_head_t *list, struct ll_list_ext *ext, unsigned failures)
+{
+    if (ext && (ext->flags & LL_LIST_PERCPU))
+        return;  /* Always buffered; the score would only deflate it. */
+    if (ext && (ext->flags & LL_LIST_COMBINING))
+        return;  /* Never inflated; see list_flags_valid(). */
+    bool striped = ext && atomic_load_explicit(&ext->striped, memory_order_acquire);
+    if (striped) {
+        /* Acquire pairs with the release in stripes_inflate(), as in ll_list_stripes(). */
+        stripe_set_t *set = atomic_load_explicit(&ext->stripe_set, memory_order_acquire);
+        if (set)
+            failures *= set->count;
+    }
+
+    /* Racy read-modify-write on purpose: it is a heuristic, and a plain
+     * store on a line the insert just wrote costs nothing extra. */
+    uint32_t score = atomic_load_explicit(&list->contention, memory_order_relaxed);
+    uint32_t next = score - (score >> CONTENTION_DECAY_SHIFT) +
+                    failures * CONTENTION_FAIL_WEIGHT;
+    if (next != score)
+        atomic_store_explicit(&list->contention, next, memory_order_relaxed);
+
+    if (!striped && next >= STRIPE_INFLATE_SCORE)
+        stripes_inflate(list);
+    else if (striped && next <= STRIPE_DEFLATE_SCORE) {
+        atomic_store_explicit(&ext->striped, false, memory_order_seq_cst);
+        stripes_drain(list);
+    }
+}
+
+/* Heat counters (track_contention domains); no-ops for other lists. */
+static inline void heat_note_cas(struct ll_list_ext *ext, unsigned failures)
+{
+    if (failures && ext && ext->heat)
+        atomic_fetch_add_explicit(&ext->cas_failures, failures, memory_order_relaxed);
+}
+
+static void heat_reader_enter(ll_head_t *list)
+{
+    struct ll_list_ext *ext = atomic_load_explicit(&list->ext, memory_order_acquire);
+    if (!ext || !ext->heat)
+        return;
+    uint32_t n = atomic_fetch_add_explicit(&ext->readers, 1, memory_order_relaxed) + 1;
+    uint32_t max = atomic_load_explicit(&ext->readers_max, memory_order_relaxed);
+    while (n > max && !atomic_compare_exchange_weak_explicit(&ext->readers_max, &max, n,
+                                                             memory_order_relaxed,
+                                                             memory_order_relaxed))
+        ;
+}
+
+static void heat_reader_exit(ll_head_t *list)
+{
+    struct ll_list_ext *ext = atomic_load_explicit(&list->ext, memory_order_acquire);
+    if (ext && ext->heat)
+        atomic_fetch_sub_explicit(&ext->readers, 1, memory_order_relaxed);
+}
+
+/* ============== Consumer Parking ============== */
+
+#ifdef __linux__
+static void futex_wait(_Atomic uint32_t *addr, uint32_t val, const struct timespec *rel)
+{
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAIT_PRIVATE, val, rel, NULL, 0);
+}
+
+static void futex_wake(_Atomic uint32_t *addr, int count)
+{
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+#else
+/* No futex: nap briefly and let the caller re-check the list. */
+static void futex_wait(_Atomic uint32_t *addr, uint32_t val, const struct timespec *rel)
+{
+    struct timespec nap = {0, 1000000};
+    if (atomic_load_explicit(addr, memory_order_acquire) != val)
+        return;
+    if (rel && (rel->tv_sec == 0 && rel->tv_nsec < nap.tv_nsec))
+        nap = *rel;
+    nanosleep(&nap, NULL);
+}
+
+static void futex_wake(_Atomic uint32_t *addr, int count)
+{
+    (void)addr;
+    (void)count;
+}
+#endif
+
+/* Add one to an eventfd (any fd taking 8-byte writes works). */
+static void event_signal(int fd)
+{
+    uint64_t one = 1;
+    /* EAGAIN means the counter is saturated: the consumer is signaled anyway. */
+    ssize_t n = write(fd, &one, sizeof(one));
+    (void)n;
+}
+
+/*
+ * Called after every successful insert. Inserts take their txn id and CAS
+ * the head with seq_cst. Consumers announce themselves (in waiters, or by
+ * arming the eventfd) before a seq_cst fence and a final look at the list.
+ * Either the consumer sees the node or the insert sees the consumer.
+ * Every list pays for this, waited on or not: the txn fetch_add and head
+ * CAS are seq_cst, and so are the loads here, up to three per insert.
+ */
+static void insert_notify(ll_head_t *list)
+{
+    struct ll_list_ext *ext = atomic_load_explicit(&list->ext, memory_order_seq_cst);
+    if (!ext)
+        return;
+    if (atomic_load_explicit(&ext->waiters, memory_order_seq_cst)) {
+        atomic_fetch_add_explicit(&ext->wait_seq, 1, memory_order_seq_cst);
+        futex_wake(&ext->wait_seq, 1);
+    }
+    /* Only the insert that disarms signals, so a burst costs one write. */
+    if (atomic_load_explicit(&ext->event_armed, memory_order_seq_cst) &&
+        atomic_exchange_explicit(&ext->event_armed, false, memory_order_acq_rel)) {
+        int fd = atomic_load_explicit(&ext->event_fd, memory_order_acquire);
+        if (fd >= 0)
+            event_signal(fd);
+    }
+}
+
+/*
+ * Arm the list's eventfd after a consumer found the list empty. Returns
+ * true if the caller must look at the list again, since an insert that
+ * landed before the arm did not signal.
+ */
+static bool event_arm(struct ll_list_ext *ext)
+{
+    if (!ext || atomic_load_explicit(&ext->event_fd, memory_order_relaxed) < 0 ||
+        atomic_load_explicit(&ext->event_armed, memory_order_relaxed))
+        return false;
+    atomic_store_explicit(&ext->event_armed, true, memory_order_seq_cst);
+    atomic_thread_fence(memory_order_seq_cst);
+    return true;
+}
+
+/* Time left until deadline, or false if it has passed. */
+static bool time_remaining(const struct timespec *deadline, struct timespec *rel)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    rel->tv_sec = deadline->tv_sec - now.tv_sec;
+    rel->tv_nsec = deadline->tv_nsec - now.tv_nsec;
+    if (rel->tv_nsec < 0) {
+        rel->tv_sec--;
+        rel->tv_nsec += 1000000000L;
+    }
+    return rel->tv_sec > 0 || (rel->tv_sec == 0 && rel->tv_nsec > 0);
+}
+
+/* ============== List Lifecycle ============== */
+
+static void list_init_fields(ll_head_t *list, ll_domain_t *domain)
+{
+    atomic_store_explicit(&list->head, (uintptr_t)0, memory_order_release);
+    atomic_store_explicit(&list->commit_id, 1, memory_order_release);
+    list->domain = domain;
+    atomic_store_explicit(&list->ext, NULL, memory_order_release);
+    atomic_store_explicit(&list->contention, 0, memory_order_relaxed);
+}
+
+static bool list_flags_valid(unsigned flags)
+{
+    if (flags & ~LL_LIST_FLAGS_ALL)
+        return false;
+    /* The combiner pops from the head chain only; stripes would hide inserts from it. */
+    if ((flags & (LL_LIST_PERCPU | LL_LIST_STRIPED)) && (flags & LL_LIST_COMBINING))
+        return false;
+    /* Wait-free inserts bypass the combiner, stripes and elimination. */
+    if ((flags & LL_LIST_WAITFREE) && (flags & ~LL_LIST_WAITFREE))
+        return false;
+    return true;
+}
+
+/*
+ * Check a Prometheus label set: name="value" pairs separated by commas,
+ * names matching [a-zA-Z_][a-zA-Z0-9_]* and not reserved ("__" prefix),
+ * values quoted with only \\, \" and \n escaped.
+ */
+static bool list_labels_valid(const char *p)
+{
+    do {
+        if (!((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z') || *p == '_') ||
+            (p[0] == '_' && p[1] == '_'))
+            return false;
+        while ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z') ||
+               (*p >= '0' && *p <= '9') || *p == '_')
+            p++;
+        if (*p++ != '=' || *p++ != '"')
+            return false;
+        for (; *p != '"'; p++) {
+            if (*p == '\\' && (p[1] == '\\' || p[1] == '"' || p[1] == 'n'))
+                p++;
+            else if (*p == '\0' || *p == '\\' || *p == '\n')
+                return false;
+        }
+        p++;
+    } while (*p++ == ',');
+    return p[-1] == '\0';
+}
+
+/*
+ * Put a list on its domain's registry, which ll_stats_format_prometheus()
+ * and ll_domain_top_contended() walk.
+ */
+static void list_register(ll_head_t *list, struct ll_list_ext *ext)
+{
+    ll_domain_t *domain = list->domain;
+    ext->list = list;
+    pthread_mutex_lock(&domain->lists_lock);
+    ext->lists_next = domain->lists;
+    domain->lists = ext;
+    pthread_mutex_unlock(&domain->lists_lock);
+}
+
+static void list_unregister(ll_head_t *list, struct ll_list_ext *ext)
+{
+    ll_domain_t *domain = list->domain;
+    pthread_mutex_lock(&domain->lists_lock);
+    struct ll_list_ext **pp = &domain->lists;
+    while (*pp != ext)
+        pp = &(*pp)->lists_next;
+    *pp = ext->lists_next;
+    pthread_mutex_unlock(&domain->lists_lock);
+}
+
+/* Allocate and register the list's extension state if anything needs it. */
+static int list_attach_ext(ll_head_t *list, unsigned flags, const char *labels)
+{
+    bool heat = list->domain->track_contention;
+    if (!flags && !labels && !heat)
+        return LL_OK;
+
+    struct ll_list_ext *ext = ext_alloc(flags);
+    if (!ext)
+        return LL_ERR_NOMEM;
+    if (labels) {
+        ext->labels = strdup(labels);
+        if (!ext->labels) {
+            free(ext);
+            return LL_ERR_NOMEM;
+        }
+    }
+    ext->heat = heat;
+    if (labels || heat)
+        list_register(list, ext);
+    atomic_store_explicit(&list->ext, ext, memory_order_release);
+    return LL_OK;
+}
+
+int ll_init(ll_head_t *list, ll_domain_t *domain)
+{
+    if (!list || !domain)
+        return LL_ERR_INVAL;
+
+    list_init_fields(list, domain);
+    return list_attach_ext(list, 0, NULL);
+}
+
+int ll_init_ex(ll_head_t *list, ll_domain_t *domain, const ll_list_config_t *config)
+{
+    bool labeled = config && config->labels && *config->labels;
+    if (!list || !domain || (config && !list_flags_valid(config->flags)))
+        return LL_ERR_INVAL;
+    if (labeled && !list_labels_valid(config->labels))
+        return LL_ERR_INVAL;
+    list_init_fields(list, domain);
+    int rc = list_attach_ext(list, config ? config->flags : 0,
+                             labeled ? config->labels : NULL);
+    if (rc != LL_OK || !config)
+        return rc;
+
+    if (config->flags & (LL_LIST_STRIPED | LL_LIST_PERCPU)) {
+        if (!stripes_inflate(list)) {
+            ll_destroy(list, NULL);
+            return LL_ERR_NOMEM;
+        }
+        /* Start as if just inflated, so quiet inserts deflate it gradually. */
+        atomic_store_explicit(&list->contention, STRIPE_INFLATE_SCORE, memory_order_relaxed);
+    }
+    return LL_OK;
+}
+
+unsigned ll_list_stripes(ll_head_t *list)
+{
+    struct ll_list_ext *ext = list ? atomic_load_explicit(&list->ext, memory_order_acquire) : NULL;
+    if (!ext || !atomic_load_explicit(&ext->striped, memory_order_acquire))
+        return 0;
+    return atomic_load_explicit(&ext->stripe_set, memory_order_acquire)->count;
+}
+
+/* Order of ll_domain_top_contended(): CAS failures, then commits. */
+static bool heat_hotter(const ll_list_heat_t *a, const ll_list_heat_t *b)
+{
+    if (a->cas_failures != b->cas_failures)
+        return a->cas_failures > b->cas_failures;
+    return a->commits > b->commits;
+}
+
+int ll_domain_top_contended(const ll_domain_t *domain, ll_list_heat_t *out, size_t k)
+{
+    if (!domain || (!out && k))
+        return LL_ERR_INVAL;
+
+    ll_domain_t *d = (ll_domain_t *)domain;
+    size_t found = 0;
+    pthread_mutex_lock(&d->lists_lock);
+    for (struct ll_list_ext *ext = d->lists; ext && k; ext = ext->lists_next) {
+        if (!ext->heat)
+            continue;
+        ll_list_heat_t h;
+        h.list = ext->list;
+        h.labels = ext->labels;
+        h.cas_failures = atomic_load_explicit(&ext->cas_failures, memory_order_relaxed);
+        h.commits = atomic_load_explicit(&ext->list->commit_id, memory_order_relaxed) - 1;
+        h.readers = atomic_load_explicit(&ext->readers, memory_order_relaxed);
+        h.readers_max = atomic_load_explicit(&ext->readers_max, memory_order_relaxed);
+        if (!h.cas_failures && !h.commits && !h.readers_max)
+            continue;
+
+        /* Insertion into out[], kept sorted hottest first. */
+        size_t pos = found < k ? found : k;
+        while (pos > 0 && heat_hotter(&h, &out[pos - 1]))
+            pos--;
+        if (pos == k)
+            continue;
+        size_t last = found < k ? found : k - 1;
+        memmove(&out[pos + 1], &out[pos], (last - pos) * sizeof(*out));
+        out[pos] = h;
+        if (found < k)
+            found++;
+    }
+    pthread_mutex_unlock(&d->lists_lock);
+    return (int)found;
+}
+
+void ll_destroy(ll_head_t *list, void (*free_cb)(void *))
+{
+    if (!list)
+        return;
+
+    /* Free all nodes (assumes no concurrent access). */
+    stripes_drain(list);
+    versioned_node_t *curr = ptr_unmask(
+        atomic_load_explicit(&list->head, memory_order_acquire));
+    while (curr) {
+        versioned_node_t *next = ptr_unmask(next_load(curr));
+        /* A pop that could not unlink its node leaves it marked here. */
+        if (free_cb && !node_is_marker(curr) &&
+            atomic_load_explicit(&curr->removed_txn_id, memory_order_relaxed) != RID_POPPED)
+            free_cb(curr->user_elm);
+        free(curr);
+        curr = next;
+    }
+    atomic_store_explicit(&list->head, (uintptr_t)0, memory_order_release);
+    atomic_store_explicit(&list->contention, 0, memory_order_relaxed);
+
+    struct ll_list_ext *ext = atomic_exchange_explicit(&list->ext, NULL, memory_order_acq_rel);
+    if (ext) {
+        if (ext->list)
+            list_unregister(list, ext);
+        free(ext->labels);
+        free(atomic_load_explicit(&ext->stripe_set, memory_order_relaxed));
+        free(atomic_load_explicit(&ext->segments, memory_order_relaxed));
+    }
+    free(ext);
+}
+
+/* ============== Flat Combining ============== */
+
+/*
+ * Hot-head lists created with LL_LIST_COMBINING route ll_insert_head() and
+ * ll_remove_first() through publication records. Whichever thread takes
+ * fc_busy becomes the combiner and applies every published operation:
+ * pops are paired with the newest inserts of the same batch, the remaining
+ * inserts are spliced in with one txn-id range and one head CAS, and any
+ * remaining pops run back to back. A waiter whose record is still pending
+ * when fc_busy is released combines for itself, so a request waits for at
+ * most one session of FC_MAX_PASSES passes.
+ */
+
+static inline void fc_finish(fc_record_t *rec, int result)
+{
+    rec->result = result;
+    atomic_store_explicit(&rec->op, FC_DONE, memory_order_release);
+}
+
+static void fc_publish_inserts(ll_head_t *list, ll_thread_state_t *state,
+                               fc_record_t **ins, size_t n)
+{
+    /* ins[0] ends up deepest, ins[n - 1] at the head, matching n direct inserts. */
+    uint64_t base = atomic_fetch_add_explicit(&list->commit_id, n, memory_order_seq_cst);
+    for (size_t i = 0; i < n; i++) {
+        versioned_node_t *w = ins[i]->node;
+        w->insert_txn_id = base + i;
+        if (i > 0)
+            atomic_store_explicit(&w->next, (uintptr_t)ins[i - 1]->node,
+                                  memory_order_relaxed);
+    }
+
+    versioned_node_t *first = ins[0]->node;
+    versioned_node_t *last = ins[n - 1]->node;
+    backoff_t backoff;
+    backoff_init(&backoff, list->domain, &state->backoff_seed);
+    uintptr_t old_head = atomic_load_explicit(&list->head, memory_order_acquire);
+    for (;;) {
+        atomic_store_explicit(&first->next, old_head, memory_order_release);
+        if (atomic_compare_exchange_weak_explicit(
+                &list->head, &old_head, (uintptr_t)last,
+                memory_order_seq_cst, memory_order_acquire))
+            break;
+        backoff_pause(&backoff);
+    }
+
+    for (size_t i = 0; i < n; i++)
+        fc_finish(ins[i], LL_OK);
+}
+
+static void fc_combine(ll_head_t *list, struct ll_list_ext *ext, ll_thread_state_t *state)
+{
+    fc_record_t *ins[FC_SLOTS];
+    fc_record_t *pops[FC_SLOTS];
+
+    for (int pass = 0; pass < FC_MAX_PASSES; pass++) {
+        size_t ni = 0, np = 0;
+        for (size_t i = 0; i < FC_SLOTS; i++) {
+            int op = atomic_load_explicit(&ext->fc[i].op, memory_order_acquire);
+            if (op == FC_INSERT)
+                ins[ni++] = &ext->fc[i];
+            else if (op == FC_POP)
+                pops[np++] = &ext->fc[i];
+        }
+        if (ni + np == 0)
+            return;
+        bool more = ni + np > 1;  /* Others are active; look again after this pass. */
+
+        /* Each pop takes the newest insert; neither node reaches the list. */
+        while (ni > 0 && np > 0) {
+            fc_record_t *in = ins[--ni];
+            fc_record_t *pop = pops[--np];
+            pop->elm = in->elm;
+            free(in->node);
+            fc_finish(in, LL_OK);
+            fc_finish(pop, LL_OK);
+        }
+
+        if (ni > 0)
+            fc_publish_inserts(list, state, ins, ni);
+
+        int rc = LL_OK;
+        uint64_t snapshot = atomic_load_explicit(&list->commit_id, memory_order_acquire);
+        for (size_t i = 0; i < np; i++) {
+            if (rc == LL_OK)
+                rc = list_pop_first(&list->head, snapshot, list->domain, state,
+                                    NULL, &pops[i]->elm);
+            fc_finish(pops[i], rc);
+        }
+        if (!more)
+            return;
+    }
+}
+
+/*
+ * Publish an operation and wait for a combiner to apply it. Returns
+ * false if the thread is alone in the domain or no record could be
+ * claimed; the caller then takes the direct CAS path.
+ */
+static bool fc_submit(ll_head_t *list, struct ll_list_ext *ext, ll_thread_state_t *state,
+                      int op, void *elm, versioned_node_t *node, int *result, void **out)
+{
+    /* Nobody to combine with. */
+    if (atomic_load_explicit(&list->domain->active_threads, memory_order_relaxed) <= 1)
+        return false;
+
+    fc_record_t *rec = NULL;
+    for (size_t i = 0; i < FC_PROBES && !rec; i++) {
+        fc_record_t *r = &ext->fc[(state->index + i) % FC_SLOTS];
+        int expected = FC_EMPTY;
+        if (atomic_compare_exchange_strong_explicit(&r->op, &expected, FC_CLAIMED,
+                                                    memory_order_acquire,
+                                                    memory_order_relaxed))
+            rec = r;
+    }
+    if (!rec)
+        return false;
+
+    rec->elm = elm;
+    rec->node = node;
+    atomic_store_explicit(&rec->op, op, memory_order_release);
+
+    unsigned spins = 0;
+    while (atomic_load_explicit(&rec->op, memory_order_acquire) != FC_DONE) {
+        if (!atomic_load_explicit(&ext->fc_busy, memory_order_relaxed) &&
+            !atomic_exchange_explicit(&ext->fc_busy, true, memory_order_acquire)) {
+            fc_combine(list, ext, state);
+            atomic_store_explicit(&ext->fc_busy, false, memory_order_release);
+            continue;
+        }
+        if (++spins < FC_SPINS_BEFORE_YIELD)
+            cpu_relax();
+        else
+            sched_yield();
+    }
+
+    *result = rec->result;
+    if (out && rec->result == LL_OK)
+        *out = rec->elm;
+    atomic_store_explicit(&rec->op, FC_EMPTY, memory_order_release);
+    return true;
+}
+
+/* ============== Insert Operations ============== */
+
+static int list_insert(ll_head_t *list, void *elm)
+{
+    if (!list || !elm)
+        return LL_ERR_INVAL;
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (!state)
+        return LL_ERR_NOTHREAD;
+    qsbr_quiescent(state);
+    STAT_ADD(state, inserts, 1);
+
+    /* Allocate wrapper node, reusing one left over by an eliminated insert. */
+    versioned_node_t *w = state->spare_node;
+    if (w)
+        state->spare_node = NULL;
+    else
+        w = (versioned_node_t *)aligned_alloc(alignof(versioned_node_t),
+                                              sizeof(versioned_node_t));
+    if (!w)
+        return LL_ERR_NOMEM;
+
+    w->user_elm = elm;
+    atomic_store_explicit(&w->removed_txn_id, (uint64_t)0, memory_order_release);
+
+    struct ll_list_ext *ext = atomic_load_explicit(&list->ext, memory_order_acquire);
+    int rc;
+    if (ext && (ext->flags & LL_LIST_COMBINING) &&
+        fc_submit(list, ext, state, FC_INSERT, elm, w, &rc, NULL)) {
+        if (rc == LL_OK) {
+            PROBE3(insert, list, elm, (uint64_t)0);  /* The combiner picked the txn id. */
+            insert_notify(list);
+        }
+        return rc;
+    }
+
+    /* Get transaction ID AFTER allocation succeeds (seq_cst: see insert_notify()).
+     * Per-CPU buffered nodes get theirs when merged. */
+    bool percpu = ext && (ext->flags & LL_LIST_PERCPU);
+    if (percpu)
+        w->insert_txn_id = insert_stamp(state);
+    else
+        w->insert_txn_id = atomic_fetch_add_explicit(&list->commit_id, 1,
+                                                      memory_order_seq_cst);
+    /* w may be popped and freed as soon as it is linked. */
+    uint64_t txn_id = w->insert_txn_id;
+
+    if (ext && (ext->flags & LL_LIST_WAITFREE)) {
+        /* Publish, then link; readers reaching w in between wait in next_load(). */
+        atomic_store_explicit(&w->next, NODE_PENDING, memory_order_relaxed);
+        uintptr_t old_head = atomic_exchange_explicit(&list->head, (uintptr_t)w,
+                                                      memory_order_seq_cst);
+        atomic_store_explicit(&w->next, old_head, memory_order_release);
+        PROBE3(insert, list, elm, txn_id);
+        insert_notify(list);
+        return LL_OK;
+    }
+
+    /* CAS loop to insert at head, or at this thread's stripe when inflated. */
+    atomic_uintptr_t *target = &list->head;
+    stripe_t *stripe = NULL;
+    if (ext && atomic_load_explicit(&ext->striped, memory_order_acquire)) {
+        stripe_set_t *set = atomic_load_explicit(&ext->stripe_set, memory_order_acquire);
+        int cpu = percpu ? current_cpu() : -1;
+        stripe = &set->stripes[(cpu >= 0 ? (size_t)cpu : state->index) % set->count];
+        target = &stripe->head;
+    }
+
+    bool elim = ext && (ext->flags & LL_LIST_ELIMINATION);
+    unsigned failures = 0;
+    backoff_t backoff;
+    backoff_init(&backoff, list->domain, &state->backoff_seed);
+    uintptr_t old_head = atomic_load_explicit(target, memory_order_acquire);
+    for (;;) {
+        atomic_store_explicit(&w->next, old_head, memory_order_release);
+        /* seq_cst pairs with waiting consumers; see insert_notify(). */
+        if (atomic_compare_exchange_weak_explicit(
+                target, &old_head, (uintptr_t)w,
+                memory_order_seq_cst, memory_order_acquire))
+            break;
+        failures++;
+        PROBE3(cas_retry, list, LL_OP_INSERT, failures);
+        trace_note(state, TRACE_CAS_FAIL, list, LL_OP_INSERT);
+        if (elim && elim_offer(ext, state, elm)) {
+            state->spare_node = w;
+            contention_note(list, ext, failures);
+            heat_note_cas(ext, failures);
+            STAT_ADD(state, insert_retries, failures);
+            PROBE3(insert, list, elm, txn_id);
+            return LL_OK;
+        }
+        backoff_pause(&backoff);
+    }
+    heat_note_cas(ext, failures);
+    STAT_ADD(state, insert_retries, failures);
+
+    if (stripe && percpu) {
+        /* Per-CPU lists never deflate; just bound how much sits unmerged. */
+        if (atomic_fetch_add_explicit(&stripe->pending, 1, memory_order_relaxed) + 1 >=
+            PERCPU_FLUSH_NODES)
+            stripes_drain(list);
+    } else if (stripe) {
+        /*
+         * A push that raced with deflation must not be left behind on a
+         * stripe, or later inserts to the head would end up below it.
+         */
+        atomic_thread_fence(memory_order_seq_cst);
+        if (!atomic_load_explicit(&ext->striped, memory_order_relaxed))
+            stripes_drain(list);
+    }
+
+    if (!ext || !(ext->flags & LL_LIST_COMBINING))
+        contention_note(list, ext, failures);
+    PROBE3(insert, list, elm, txn_id);
+    insert_notify(list);
+    return LL_OK;
+}
+
+int ll_insert_head(ll_head_t *list, void *elm)
+{
+    HIST_BEGIN();
+    uint64_t trace_start = trace_op_begin();
+    int rc = list_insert(list, elm);
+    trace_op_end(LL_OP_INSERT, list, trace_start);
+    HIST_END(LL_OP_INSERT);
+    return rc;
+}
+/* ============== Remove Operations ============== */
+
+/*
+ * Stamp the first live node holding elm with txn_id. Walks hand-over-hand
+ * as count_visible() does, helping unlink claimed nodes; QSBR domains walk
+ * plainly. A node a pop has claimed (NODE_MARK) or already popped is not
+ * ours to remove, and the CAS keeps a concurrent remove or pop from
+ * overwriting removed_txn_id; its winner owns the element. Hazard domains
+ * need both internal slots.
+ */
+static bool remove_walk(atomic_uintptr_t *head, void *elm, uint64_t txn_id,
+                        ll_thread_state_t *state, uint64_t *insert_txn_id)
+{
+    bool plain = state->qsbr;
+    for (;;) {
+        atomic_uintptr_t *link = head;
+        versioned_node_t *curr = ptr_unmask(atomic_load_explicit(link, memory_order_acquire));
+        int slot = 0;
+        bool retry = false;
+
+        while (curr) {
+            if (!plain) {
+                hp_acquire(state, slot, curr);
+                if (atomic_load_explicit(link, memory_order_acquire) != (uintptr_t)curr) {
+                    retry = true;
+                    break;
+                }
+            }
+
+            uintptr_t next_val = next_load(curr);
+            if (next_val & NODE_MARK) {
+                if (!plain && unlink_node(link, curr, next_val))
+                    retire_node(state, curr);
+                curr = ptr_unmask(next_val);
+                continue;
+            }
+
+            uint64_t expected = 0;
+            if (curr->user_elm == elm &&
+                atomic_compare_exchange_strong_explicit(&curr->removed_txn_id, &expected,
+                                                        txn_id, memory_order_acq_rel,
+                                                        memory_order_relaxed)) {
+                *insert_txn_id = curr->insert_txn_id;
+                if (!plain)
+                    hp_release_all(state);
+                return true;
+            }
+
+            link = &curr->next;
+            slot ^= 1;
+            curr = ptr_unmask(next_val);
+        }
+
+        if (!plain)
+            hp_release_all(state);
+        if (!retry)
+            return false;
+    }
+}
+
+static int list_remove(ll_head_t *list, void *elm)
+{
+    if (!list || !elm)
+        return LL_ERR_INVAL;
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (!state)
+        return LL_ERR_NOTHREAD;
+    if (!state->qsbr && state->hp_count < HP_SLOTS_INTERNAL)
+        return LL_ERR_FULL;  /* The walk protects prev and curr. */
+    qsbr_quiescent(state);
+    STAT_ADD(state, removes, 1);
+
+    stripes_drain(list);
+
+    /* Get transaction ID for the remove. */
+    uint64_t txn_id = atomic_fetch_add_explicit(&list->commit_id, 1,
+                                                 memory_order_acq_rel);
+
+    uint64_t insert_txn_id;
+    if (!remove_walk(&list->head, elm, txn_id, state, &insert_txn_id))
+        return LL_ERR_NOTFOUND;
+    segment_note_tombstone(list, insert_txn_id);
+    PROBE3(remove, list, elm, txn_id);
+    return LL_OK;
+}
+
+int ll_remove(ll_head_t *list, void *elm)
+{
+    HIST_BEGIN();
+    uint64_t trace_start = trace_op_begin();
+    int rc = list_remove(list, elm);
+    trace_op_end(LL_OP_REMOVE, list, trace_start);
+    HIST_END(LL_OP_REMOVE);
+    return rc;
+}
+
+static int remove_first_once(ll_head_t *list, struct ll_list_ext *ext,
+                             ll_thread_state_t *state, void **out_elm)
+{
+    int rc;
+    if (ext && (ext->flags & LL_LIST_COMBINING) &&
+        fc_submit(list, ext, state, FC_POP, NULL, NULL, &rc, out_elm))
+        return rc;
+
+    stripes_drain(list);
+    uint64_t snapshot = atomic_load_explicit(&list->commit_id, memory_order_acquire);
+    struct ll_list_ext *elim = ext && (ext->flags & LL_LIST_ELIMINATION) ? ext : NULL;
+    return list_pop_first(&list->head, snapshot, list->domain, state, elim, out_elm);
+}
+
+static int list_remove_first(ll_head_t *list, void **out_elm)
+{
+    if (!list || !out_elm)
+        return LL_ERR_INVAL;
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (!state)
+        return LL_ERR_NOTHREAD;
+    if (state->hp_count < HP_SLOTS_INTERNAL)
+        return LL_ERR_FULL;  /* Unlinking past the head needs prev and curr. */
+    qsbr_quiescent(state);
+    STAT_ADD(state, remove_firsts, 1);
+
+    struct ll_list_ext *ext = atomic_load_explicit(&list->ext, memory_order_acquire);
+    int rc = remove_first_once(list, ext, state, out_elm);
+    if (rc == LL_ERR_NOTFOUND && event_arm(ext))
+        rc = remove_first_once(list, ext, state, out_elm);
+    return rc;
+}
+
+int ll_remove_first(ll_head_t *list, void **out_elm)
+{
+    HIST_BEGIN();
+    uint64_t trace_start = trace_op_begin();
+    int rc = list_remove_first(list, out_elm);
+    if (rc == LL_OK)
+        PROBE2(remove_first, list, *out_elm);
+    trace_op_end(LL_OP_REMOVE_FIRST, list, trace_start);
+    HIST_END(LL_OP_REMOVE_FIRST);
+    return rc;
+}
+
+int ll_remove_first_wait(ll_head_t *list, void **out_elm, int timeout_ms)
+{
+    /* A zero timeout is a plain poll, with ll_remove_first()'s result. */
+    int rc = ll_remove_first(list, out_elm);
+    if (rc != LL_ERR_NOTFOUND || timeout_ms == 0)
+        return rc;
+
+    struct ll_list_ext *ext = ext_get_or_create(list);
+    if (!ext)
+        return LL_ERR_NOMEM;
+
+    struct timespec deadline;
+    if (timeout_ms > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    for (;;) {
+        uint32_t seq = atomic_load_explicit(&ext->wait_seq, memory_order_acquire);
+        atomic_fetch_add_explicit(&ext->waiters, 1, memory_order_seq_cst);
+        atomic_thread_fence(memory_order_seq_cst);
+
+        rc = ll_remove_first(list, out_elm);
+        struct timespec rel;
+        bool expired = timeout_ms > 0 && !time_remaining(&deadline, &rel);
+        if (rc == LL_ERR_NOTFOUND && !expired) {
+            ll_thread_state_t *state = get_tls_thread_state();
+            bool offline = qsbr_offline(state);
+            futex_wait(&ext->wait_seq, seq, timeout_ms > 0 ? &rel : NULL);
+            if (offline)
+                qsbr_online(state, state->domain);
+        }
+        atomic_fetch_sub_explicit(&ext->waiters, 1, memory_order_relaxed);
+
+        if (rc != LL_ERR_NOTFOUND)
+            return rc;
+        if (expired)
+            return LL_ERR_TIMEDOUT;
     }
+}
 
-    /* Find next visible node. */
+int ll_attach_eventfd(ll_head_t *list, int fd, unsigned flags)
+{
+    if (!list || flags)
+        return LL_ERR_INVAL;
+
+    if (fd < 0) {
+        struct ll_list_ext *ext = atomic_load_explicit(&list->ext, memory_order_acquire);
+        if (ext) {
+            atomic_store_explicit(&ext->event_armed, false, memory_order_relaxed);
+            atomic_store_explicit(&ext->event_fd, -1, memory_order_release);
+        }
+        return LL_OK;
+    }
+
+    struct ll_list_ext *ext = ext_get_or_create(list);
+    if (!ext)
+        return LL_ERR_NOMEM;
+    atomic_store_explicit(&ext->event_armed, false, memory_order_relaxed);
+    atomic_store_explicit(&ext->event_fd, fd, memory_order_release);
+    /* Start disarmed and signaled: the consumer's first drain arms it. */
+    event_signal(fd);
+    return LL_OK;
+}
+
+/* ============== Iterator & Traversal ============== */
+
+int ll_iterator_begin(ll_head_t *list, ll_iterator_t *iter)
+{
+    if (!list || !iter)
+        return LL_ERR_INVAL;
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (!state)
+        return LL_ERR_NOTHREAD;
+    qsbr_quiescent(state);
+    STAT_ADD(state, iterations, 1);
+
+#ifdef LL_HISTOGRAMS
+    state->hist.iter_start_ns = monotonic_ns();
+#endif
+    state->trace_iter_start = state->trace ? monotonic_ns() : 0;
+    stripes_drain(list);
+    iter->list = list;
+    iter->snapshot = snapshot_publish(state, &list->commit_id);
+    iter->current_node = NULL;
+    heat_reader_enter(list);
+    PROBE2(snapshot_begin, list, iter->snapshot);
+
+    return LL_OK;
+}
+
+/*
+ * Walk without hand-over-hand validation. QSBR domains need no hazards at
+ * all: nothing this thread reached is freed before its next quiescent
+ * state, which ll_iterator_end() precedes. Single-slot domains cannot hold
+ * a node and its successor at once; ll_remove_first() is unavailable
+ * there anyway.
+ */
+static void *iterator_next_plain(ll_iterator_t *iter, ll_thread_state_t *state)
+{
+    versioned_node_t *curr;
+
+    if (iter->current_node == NULL)
+        curr = ptr_unmask(atomic_load_explicit(&iter->list->head, memory_order_acquire));
+    else
+        curr = ptr_unmask(next_load((versioned_node_t *)iter->current_node));
+
+    uint64_t skipped = 0;
     while (curr) {
+        if (state->qsbr) {
+            if (node_visible(curr, iter->snapshot)) {
+                iter->current_node = curr;
+                break;
+            }
+            skipped++;
+            curr = ptr_unmask(next_load(curr));
+            continue;
+        }
+
         hp_acquire(state, 0, curr);
 
         if (node_visible(curr, iter->snapshot)) {
             iter->current_node = curr;
             hp_release(state, 0);
-            return curr->user_elm;
+            break;
         }
 
-        versioned_node_t *next = ptr_unmask(
-            atomic_load_explicit(&curr->next, memory_order_acquire));
+        skipped++;
+        versioned_node_t *next = ptr_unmask(next_load(curr));
         hp_release(state, 0);
         curr = next;
     }
 
-    iter->current_node = NULL;
-    return NULL;
+    STAT_ADD(state, nodes_visited, skipped + (curr != NULL));
+    STAT_ADD(state, nodes_skipped, skipped);
+    if (!curr)
+        iter->current_node = NULL;
+    return curr ? curr->user_elm : NULL;
+}
+
+void *ll_iterator_next(ll_iterator_t *iter)
+{
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (!iter || !iter->list || !state)
+        return NULL;
+    if (state->qsbr || state->hp_count < HP_SLOTS_INTERNAL)
+        return iterator_next_plain(iter, state);
+
+    /*
+     * The element returned by the previous call is still protected in
+     * slot 1.  Walk hand-over-hand from it, validating each successor
+     * through its predecessor's link as list_pop_first() does.  If the
+     * predecessor gets removed underneath us the walk restarts from the
+     * head and skips forward to where it left off.
+     */
+    versioned_node_t *last = iter->current_node;
+    /* Another operation on this thread may have reused the slot meanwhile. */
+    bool from_last = last != NULL &&
+        atomic_load_explicit(&state->hazard_ptrs[1], memory_order_relaxed) == last;
+    uint64_t visited = 0, skipped = 0;
+
+    for (;;) {
+        atomic_uintptr_t *link = &iter->list->head;
+        bool seeking = last != NULL;
+        int slot = 0;
+        bool retry = false;
+
+        if (from_last) {
+            uintptr_t v = next_load(last);
+            if (!(v & NODE_MARK)) {
+                link = &last->next;
+                seeking = false;
+            }
+            from_last = false;
+        }
+
+        versioned_node_t *curr = ptr_unmask(atomic_load_explicit(link, memory_order_acquire));
+        while (curr) {
+            hp_acquire(state, slot, curr);
+
+            if (atomic_load_explicit(link, memory_order_acquire) != (uintptr_t)curr) {
+                retry = true;
+                break;
+            }
+
+            uintptr_t next_val = next_load(curr);
+            visited++;
+            if (seeking) {
+                /* A recycled node would carry a txn id past our snapshot. */
+                if (curr == last && curr->insert_txn_id < iter->snapshot)
+                    seeking = false;
+            } else if (node_visible(curr, iter->snapshot)) {
+                if (slot != 1)
+                    hp_acquire(state, 1, curr);
+                hp_release(state, 0);
+                iter->current_node = curr;
+                STAT_ADD(state, nodes_visited, visited);
+                STAT_ADD(state, nodes_skipped, skipped);
+                return curr->user_elm;
+            } else {
+                skipped++;
+            }
+
+            if (next_val & NODE_MARK) {
+                /* Help unlink it; the new link is validated on the next pass. */
+                if (unlink_node(link, curr, next_val))
+                    retire_node(state, curr);
+                curr = ptr_unmask(next_val);
+                continue;
+            }
+
+            link = &curr->next;
+            slot ^= 1;
+            curr = ptr_unmask(next_val);
+        }
+
+        if (!retry)
+            break;
+    }
+
+    /* Also reached when the last element was removed and unlinked before we got back to it. */
+    hp_release_all(state);
+    iter->current_node = NULL;
+    STAT_ADD(state, nodes_visited, visited);
+    STAT_ADD(state, nodes_skipped, skipped);
+    return NULL;
+}
+
+void ll_iterator_end(ll_iterator_t *iter)
+{
+    if (!iter)
+        return;
+
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (state) {
+        atomic_store_explicit(&state->active_snapshot, (uint64_t)0,
+                              memory_order_release);
+        hp_release_all(state);
+#ifdef LL_HISTOGRAMS
+        if (iter->list)
+            hist_record(LL_OP_ITERATE, state->hist.iter_start_ns);
+#endif
+        if (iter->list && state->trace_iter_start) {
+            trace_op_end(LL_OP_ITERATE, iter->list, state->trace_iter_start);
+            state->trace_iter_start = 0;
+        }
+    }
+    if (iter->list) {
+        heat_reader_exit(iter->list);
+        PROBE2(snapshot_end, iter->list, iter->snapshot);
+    }
+
+    iter->list = NULL;
+    iter->current_node = NULL;
+    iter->snapshot = 0;
+}
+
+uint64_t ll_iterator_snapshot(const ll_iterator_t *iter)
+{
+    return iter ? iter->snapshot : 0;
+}
+
+/* ============== Utility Functions ============== */
+
+/* Add one walked node to health; run is the invisible run it extends. */
+static inline void health_note(ll_list_health_t *health, versioned_node_t *n,
+                               bool visible, size_t *run)
+{
+    if (node_is_marker(n)) {
+        health->markers++;
+        return;
+    }
+    health->nodes++;
+    if (atomic_load_explicit(&n->removed_txn_id, memory_order_relaxed) != 0)
+        health->tombstones++;
+    if (visible) {
+        *run = 0;
+        return;
+    }
+    health->invisible++;
+    if (++*run > health->longest_invisible_run)
+        health->longest_invisible_run = *run;
+}
+
+/*
+ * Count nodes visible at snapshot (only those holding elm, if non-NULL),
+ * stopping at limit, and tally the chain into health (zeroed by the
+ * caller) if non-NULL. Hazard domains walk hand-over-hand as
+ * list_pop_first() does and recount from the head if a predecessor is
+ * removed underneath them; QSBR domains, single-slot domains and
+ * unregistered callers walk without per-node stores.
+ */
+static size_t count_visible_walk(ll_head_t *list, ll_thread_state_t *state,
+                                 uint64_t snapshot, const void *elm, size_t limit,
+                                 ll_list_health_t *health)
+{
+    if (state && state->domain != list->domain)
+        state = NULL;  /* Hazards in another domain protect nothing here. */
+    uint64_t visited = 0, skipped = 0;
+    if (state)
+        STAT_ADD(state, lookups, 1);
+    if (!state || state->qsbr || state->hp_count < HP_SLOTS_INTERNAL) {
+        size_t count = 0, run = 0;
+        versioned_node_t *curr = ptr_unmask(
+            atomic_load_explicit(&list->head, memory_order_acquire));
+        while (curr && count < limit) {
+            bool visible = node_visible(curr, snapshot);
+            visited++;
+            if (!visible)
+                skipped++;
+            else if (!elm || curr->user_elm == elm)
+                count++;
+            if (health)
+                health_note(health, curr, visible, &run);
+            curr = ptr_unmask(next_load(curr));
+        }
+        if (state) {
+            STAT_ADD(state, nodes_visited, visited);
+            STAT_ADD(state, nodes_skipped, skipped);
+        }
+        return count;
+    }
+
+    for (;;) {
+        size_t count = 0, run = 0;
+        atomic_uintptr_t *link = &list->head;
+        versioned_node_t *curr = ptr_unmask(atomic_load_explicit(link, memory_order_acquire));
+        int slot = 0;
+        bool retry = false;
+
+        while (curr && count < limit) {
+            hp_acquire(state, slot, curr);
+
+            if (atomic_load_explicit(link, memory_order_acquire) != (uintptr_t)curr) {
+                retry = true;
+                break;
+            }
+
+            uintptr_t next_val = next_load(curr);
+            if (next_val & NODE_MARK) {
+                if (unlink_node(link, curr, next_val))
+                    retire_node(state, curr);
+                curr = ptr_unmask(next_val);
+                continue;
+            }
+
+            bool visible = node_visible(curr, snapshot);
+            visited++;
+            if (!visible)
+                skipped++;
+            else if (!elm || curr->user_elm == elm)
+                count++;
+            if (health)
+                health_note(health, curr, visible, &run);
+            link = &curr->next;
+            slot ^= 1;
+            curr = ptr_unmask(next_val);
+        }
+
+        if (!retry) {
+            hp_release_all(state);
+            STAT_ADD(state, nodes_visited, visited);
+            STAT_ADD(state, nodes_skipped, skipped);
+            return count;
+        }
+        if (health)
+            memset(health, 0, sizeof(*health));
+    }
+}
+
+static size_t count_visible(ll_head_t *list, ll_thread_state_t *state,
+                            uint64_t snapshot, const void *elm, size_t limit,
+                            ll_list_health_t *health)
+{
+    heat_reader_enter(list);
+    size_t count = count_visible_walk(list, state, snapshot, elm, limit, health);
+    heat_reader_exit(list);
+    return count;
+}
+
+bool ll_is_empty(ll_head_t *list)
+{
+    if (!list)
+        return true;
+
+    ll_thread_state_t *state = get_tls_thread_state();
+    qsbr_quiescent(state);
+    stripes_drain(list);
+
+    uint64_t snapshot = atomic_load_explicit(&list->commit_id, memory_order_acquire);
+    return count_visible(list, state, snapshot, NULL, 1, NULL) == 0;
+}
+
+bool ll_contains(ll_head_t *list, const void *elm)
+{
+    if (!list || !elm)
+        return false;
+
+    ll_thread_state_t *state = get_tls_thread_state();
+    qsbr_quiescent(state);
+    stripes_drain(list);
+
+    uint64_t snapshot = atomic_load_explicit(&list->commit_id, memory_order_acquire);
+    return count_visible(list, state, snapshot, elm, 1, NULL) == 1;
+}
+
+size_t ll_count(ll_head_t *list)
+{
+    if (!list)
+        return 0;
+
+    ll_thread_state_t *state = get_tls_thread_state();
+    qsbr_quiescent(state);
+    stripes_drain(list);
+
+    uint64_t snapshot = atomic_load_explicit(&list->commit_id, memory_order_acquire);
+    return count_visible(list, state, snapshot, NULL, SIZE_MAX, NULL);
+}
+
+int ll_list_health(ll_head_t *list, ll_list_health_t *out)
+{
+    if (!list || !out)
+        return LL_ERR_INVAL;
+
+    ll_thread_state_t *state = get_tls_thread_state();
+    qsbr_quiescent(state);
+    stripes_drain(list);
+
+    uint64_t snapshot = atomic_load_explicit(&list->commit_id, memory_order_acquire);
+    memset(out, 0, sizeof(*out));
+    count_visible(list, state, snapshot, NULL, SIZE_MAX, out);
+    out->commit_id = snapshot;
+    out->tombstone_ratio = out->nodes ? (double)out->tombstones / (double)out->nodes : 0.0;
+    return LL_OK;
+}
+
+/* ============== Layout Analysis ============== */
+
+#define LOG2_BUCKETS 64
+#define NUMA_NODES_MAX 64
+#define NUMA_QUERY_PAGES 512           /* Pages per move_pages() call */
+
+/* What ll_debug_analyze() gathers in its walk. */
+typedef struct layout_stats {
+    uint64_t commit_id;
+    size_t nodes;                      /* Markers included */
+    size_t markers;
+    size_t forward, backward;          /* Strides to the next node, by sign */
+    size_t stride_line, stride_page;   /* Strides within a cache line / page */
+    size_t stride_log2[LOG2_BUCKETS];  /* |stride| in [2^i, 2^(i+1)) bytes */
+    size_t elm_line, elm_page;         /* Elements within a cache line / page of their node */
+    size_t elm_log2[LOG2_BUCKETS];
+    size_t visible, visible_runs, invisible_runs, longest_invisible;
+    size_t run_log2[LOG2_BUCKETS];     /* Invisible run lengths */
+    size_t page_size;
+    size_t pages;                      /* Distinct pages holding nodes */
+    bool numa;                         /* numa_pages is known */
+    size_t numa_pages[NUMA_NODES_MAX];
+} layout_stats_t;
+
+static inline unsigned log2_bucket(uintptr_t v)
+{
+    return v ? 63u - (unsigned)__builtin_clzll((unsigned long long)v) : 0;
+}
+
+static int uintptr_cmp(const void *a, const void *b)
+{
+    uintptr_t x = *(const uintptr_t *)a, y = *(const uintptr_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Count the NUMA node of each distinct page; pages[] is sorted and unique. */
+static bool layout_numa(layout_stats_t *st, const uintptr_t *pages, size_t count)
+{
+#if defined(__linux__) && defined(SYS_move_pages)
+    void *addrs[NUMA_QUERY_PAGES];
+    int status[NUMA_QUERY_PAGES];
+    for (size_t i = 0; i < count; i += NUMA_QUERY_PAGES) {
+        size_t n = count - i < NUMA_QUERY_PAGES ? count - i : NUMA_QUERY_PAGES;
+        for (size_t k = 0; k < n; k++)
+            addrs[k] = (void *)(pages[i + k] * st->page_size);
+        /* With no target nodes, move_pages() only reports where pages are. */
+        if (syscall(SYS_move_pages, 0, (unsigned long)n, addrs, NULL, status, 0) != 0)
+            return false;
+        for (size_t k = 0; k < n; k++)
+            if (status[k] >= 0 && status[k] < NUMA_NODES_MAX)
+                st->numa_pages[status[k]]++;
+    }
+    return true;
+#else
+    (void)st;
+    (void)pages;
+    (void)count;
+    return false;
+#endif
+}
+
+static int layout_collect(ll_head_t *list, layout_stats_t *st)
+{
+    long page_size = sysconf(_SC_PAGESIZE);
+    st->page_size = page_size > 0 ? (size_t)page_size : 4096;
+    st->commit_id = atomic_load_explicit(&list->commit_id, memory_order_acquire);
+
+    size_t cap = 256;
+    uintptr_t *pages = (uintptr_t *)malloc(cap * sizeof(*pages));
+    if (!pages)
+        return LL_ERR_NOMEM;
+
+    size_t run = 0;
+    bool in_visible_run = false;
+    versioned_node_t *curr = ptr_unmask(atomic_load_explicit(&list->head, memory_order_acquire));
+    while (curr) {
+        versioned_node_t *next = ptr_unmask(next_load(curr));
+        uintptr_t addr = (uintptr_t)curr;
+
+        if (st->nodes == cap) {
+            uintptr_t *grown = (uintptr_t *)realloc(pages, 2 * cap * sizeof(*pages));
+            if (!grown) {
+                free(pages);
+                return LL_ERR_NOMEM;
+            }
+            pages = grown;
+            cap *= 2;
+        }
+        pages[st->nodes++] = addr / st->page_size;
+
+        if (next) {
+            uintptr_t to = (uintptr_t)next;
+            uintptr_t stride = to > addr ? to - addr : addr - to;
+            if (to > addr)
+                st->forward++;
+            else
+                st->backward++;
+            st->stride_line += addr / CACHE_LINE == to / CACHE_LINE;
+            st->stride_page += addr / st->page_size == to / st->page_size;
+            st->stride_log2[log2_bucket(stride)]++;
+        }
+
+        if (node_is_marker(curr)) {
+            st->markers++;
+            curr = next;
+            continue;
+        }
+
+        uintptr_t elm = (uintptr_t)curr->user_elm;
+        st->elm_line += addr / CACHE_LINE == elm / CACHE_LINE;
+        st->elm_page += addr / st->page_size == elm / st->page_size;
+        st->elm_log2[log2_bucket(elm > addr ? elm - addr : addr - elm)]++;
+
+        bool visible = node_visible(curr, st->commit_id);
+        st->visible += visible;
+        if (visible && !in_visible_run) {
+            st->visible_runs++;
+            if (run)
+                st->run_log2[log2_bucket(run)]++;
+            run = 0;
+        } else if (!visible) {
+            if (run++ == 0)
+                st->invisible_runs++;
+            if (run > st->longest_invisible)
+                st->longest_invisible = run;
+        }
+        in_visible_run = visible;
+        curr = next;
+    }
+    if (run)
+        st->run_log2[log2_bucket(run)]++;
+
+    qsort(pages, st->nodes, sizeof(*pages), uintptr_cmp);
+    size_t distinct = 0;
+    for (size_t i = 0; i < st->nodes; i++)
+        if (distinct == 0 || pages[distinct - 1] != pages[i])
+            pages[distinct++] = pages[i];
+    st->pages = distinct;
+    st->numa = layout_numa(st, pages, distinct);
+    free(pages);
+    return LL_OK;
+}
+
+static void layout_text_log2(FILE *out, const char *label, const size_t *b)
+{
+    for (unsigned i = 0; i < LOG2_BUCKETS; i++)
+        if (b[i])
+            fprintf(out, "  %s [2^%u, 2^%u): %zu\n", label, i, i + 1, b[i]);
+}
+
+static void layout_json_log2(FILE *out, const size_t *b)
+{
+    unsigned end = LOG2_BUCKETS;
+    while (end > 0 && b[end - 1] == 0)
+        end--;
+    fputc('[', out);
+    for (unsigned i = 0; i < end; i++)
+        fprintf(out, "%s%zu", i ? "," : "", b[i]);
+    fputc(']', out);
+}
+
+static void layout_print_text(FILE *out, const ll_head_t *list, const layout_stats_t *st)
+{
+    size_t node_bytes = st->nodes * sizeof(versioned_node_t);
+    fprintf(out, "list %p: %zu nodes (%zu markers) at commit_id %" PRIu64 "\n",
+            (const void *)list, st->nodes, st->markers, st->commit_id);
+    fprintf(out, "stride to next node: %zu forward, %zu backward, %zu within a cache line, "
+            "%zu within a page\n", st->forward, st->backward, st->stride_line, st->stride_page);
+    layout_text_log2(out, "bytes", st->stride_log2);
+    fprintf(out, "pages: %zu of %zu bytes hold nodes, %zu would suffice\n", st->pages,
+            st->page_size, (node_bytes + st->page_size - 1) / st->page_size);
+    if (st->numa) {
+        for (unsigned i = 0; i < NUMA_NODES_MAX; i++)
+            if (st->numa_pages[i])
+                fprintf(out, "  numa node %u: %zu pages\n", i, st->numa_pages[i]);
+    } else {
+        fputs("  numa nodes unknown\n", out);
+    }
+    fprintf(out, "node to element: %zu within a cache line, %zu within a page\n",
+            st->elm_line, st->elm_page);
+    layout_text_log2(out, "bytes", st->elm_log2);
+    fprintf(out, "visibility: %zu visible in %zu runs, %zu invisible in %zu runs, "
+            "longest invisible run %zu\n", st->visible, st->visible_runs,
+            st->nodes - st->markers - st->visible, st->invisible_runs, st->longest_invisible);
+    layout_text_log2(out, "invisible run", st->run_log2);
+}
+
+static void layout_print_json(FILE *out, const ll_head_t *list, const layout_stats_t *st)
+{
+    size_t node_bytes = st->nodes * sizeof(versioned_node_t);
+    fprintf(out, "{\"list\":\"%p\",\"commit_id\":%" PRIu64 ",\"nodes\":%zu,\"markers\":%zu,"
+            "\"node_size\":%zu,\n", (const void *)list, st->commit_id, st->nodes,
+            st->markers, sizeof(versioned_node_t));
+    fprintf(out, "\"stride\":{\"forward\":%zu,\"backward\":%zu,\"same_line\":%zu,"
+            "\"same_page\":%zu,\"log2_bytes\":", st->forward, st->backward,
+            st->stride_line, st->stride_page);
+    layout_json_log2(out, st->stride_log2);
+    fprintf(out, "},\n\"pages\":{\"page_size\":%zu,\"distinct\":%zu,\"minimum\":%zu,\"numa\":",
+            st->page_size, st->pages, (node_bytes + st->page_size - 1) / st->page_size);
+    if (st->numa) {
+        fputc('{', out);
+        const char *sep = "";
+        for (unsigned i = 0; i < NUMA_NODES_MAX; i++) {
+            if (st->numa_pages[i]) {
+                fprintf(out, "%s\"%u\":%zu", sep, i, st->numa_pages[i]);
+                sep = ",";
+            }
+        }
+        fputc('}', out);
+    } else {
+        fputs("null", out);
+    }
+    fprintf(out, "},\n\"element\":{\"same_line\":%zu,\"same_page\":%zu,\"log2_bytes\":",
+            st->elm_line, st->elm_page);
+    layout_json_log2(out, st->elm_log2);
+    fprintf(out, "},\n\"visibility\":{\"visible\":%zu,\"invisible\":%zu,\"visible_runs\":%zu,"
+            "\"invisible_runs\":%zu,\"longest_invisible_run\":%zu,\"invisible_run_log2\":",
+            st->visible, st->nodes - st->markers - st->visible, st->visible_runs,
+            st->invisible_runs, st->longest_invisible);
+    layout_json_log2(out, st->run_log2);
+    fputs("}}\n", out);
+}
+
+int ll_debug_analyze(ll_head_t *list, FILE *out, ll_analyze_format_t format)
+{
+    if (!list || !out || (format != LL_ANALYZE_TEXT && format != LL_ANALYZE_JSON))
+        return LL_ERR_INVAL;
+
+    stripes_drain(list);
+
+    layout_stats_t *st = (layout_stats_t *)calloc(1, sizeof(*st));
+    if (!st)
+        return LL_ERR_NOMEM;
+    int err = layout_collect(list, st);
+    if (err == LL_OK) {
+        if (format == LL_ANALYZE_JSON)
+            layout_print_json(out, list, st);
+        else
+            layout_print_text(out, list, st);
+        err = ferror(out) ? LL_ERR_INVAL : LL_OK;
+    }
+    free(st);
+    return err;
+}
+
+/* ============== Segmented Reclamation ============== */
+
+/*
+ * ll_reclaim() splits a long chain into segments bounded by marker nodes:
+ * nodes with insert_txn_id MARKER_TXN, which no snapshot can see and no
+ * operation removes. Every reclaimer claims segments from the current
+ * round until none are left, starting a new round if it arrives after
+ * the last claim, so concurrent calls on one list divide the chain
+ * between them instead of racing over the same tombstones. Unlinks stay
+ * mark-then-CAS as everywhere else, so overlapping rounds are only wasted
+ * work, and each participant retires onto its own list and scans it.
+ *
+ * A walker places a marker after every SEGMENT_NODES live nodes it passes
+ * and removes the marker ending a segment that shrank below a quarter of
+ * that, so segments track the list as it grows and shrinks.
+ *
+ * Inserts land at the head, so segments are generations: each marker's
+ * bound is the insert_txn_id just before it, and a node belongs to the
+ * marker with the smallest bound above its own. ll_remove() counts each
+ * tombstone against its generation, and reclaim skips generations whose
+ * count is zero, so its cost follows churn rather than list length. The
+ * counts are hints: a node inserted out of txn order is charged to the
+ * wrong generation, so every GENERATION_SWEEP-th call walks them all.
+ */
+
+static segment_set_t *segments_get(ll_head_t *list)
+{
+    struct ll_list_ext *ext = atomic_load_explicit(&list->ext, memory_order_acquire);
+    return ext ? atomic_load_explicit(&ext->segments, memory_order_acquire) : NULL;
+}
+
+static segment_set_t *segments_get_or_create(ll_head_t *list)
+{
+    struct ll_list_ext *ext = ext_get_or_create(list);
+    if (!ext)
+        return NULL;
+    segment_set_t *seg = atomic_load_explicit(&ext->segments, memory_order_acquire);
+    if (seg)
+        return seg;
+
+    segment_set_t *fresh = (segment_set_t *)calloc(1, sizeof(segment_set_t));
+    if (!fresh)
+        return NULL;
+    atomic_flag_clear(&fresh->order_lock);
+    if (atomic_compare_exchange_strong_explicit(&ext->segments, &seg, fresh,
+                                                memory_order_acq_rel,
+                                                memory_order_acquire))
+        return fresh;
+    free(fresh);
+    return seg;
+}
+
+/* Claim a free markers[] slot, marking it reserved. Returns -1 if full. */
+static int segment_slot_reserve(segment_set_t *seg)
+{
+    for (;;) {
+        unsigned used = atomic_load_explicit(&seg->used, memory_order_acquire);
+        for (unsigned i = 0; i < used; i++) {
+            versioned_node_t *expected = NULL;
+            if (atomic_compare_exchange_strong_explicit(&seg->markers[i], &expected,
+                                                        MARKER_RESERVED,
+                                                        memory_order_relaxed,
+                                                        memory_order_relaxed))
+                return (int)i;
+        }
+        if (used >= SEGMENT_MARKERS_MAX)
+            return -1;
+        if (!atomic_compare_exchange_weak_explicit(&seg->used, &used, used + 1,
+                                                   memory_order_relaxed,
+                                                   memory_order_relaxed))
+            continue;
+        /* The slot is visible to the scan above as soon as used moves; claim it the same way. */
+        versioned_node_t *expected = NULL;
+        if (atomic_compare_exchange_strong_explicit(&seg->markers[used], &expected,
+                                                    MARKER_RESERVED,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed))
+            return (int)used;
+    }
+}
+
+/* Open order[] for writing; readers that overlap retry. */
+static void segment_order_begin(segment_set_t *seg)
+{
+    while (atomic_flag_test_and_set_explicit(&seg->order_lock, memory_order_acquire))
+        cpu_relax();
+    unsigned seq = atomic_load_explicit(&seg->order_seq, memory_order_relaxed);
+    atomic_store_explicit(&seg->order_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
 }
 
-void ll_iterator_end(ll_iterator_t *iter)
+static void segment_order_end(segment_set_t *seg)
 {
-    if (!iter)
-        return;
+    unsigned seq = atomic_load_explicit(&seg->order_seq, memory_order_relaxed);
+    atomic_store_explicit(&seg->order_seq, seq + 1, memory_order_release);
+    atomic_flag_clear_explicit(&seg->order_lock, memory_order_release);
+}
 
-    ll_thread_state_t *state = get_tls_thread_state();
-    if (state) {
-        atomic_store_explicit(&state->active_snapshot, (uint64_t)0,
-                              memory_order_release);
+/* Position of the first entry of order[] whose bound exceeds txn. */
+static unsigned segment_order_search(segment_set_t *seg, unsigned n, uint64_t txn)
+{
+    unsigned lo = 0, hi = n;
+    while (lo < hi) {
+        unsigned mid = lo + (hi - lo) / 2;
+        unsigned slot = atomic_load_explicit(&seg->order[mid], memory_order_relaxed);
+        if (atomic_load_explicit(&seg->bounds[slot], memory_order_relaxed) > txn)
+            hi = mid;
+        else
+            lo = mid + 1;
     }
+    return lo;
+}
 
-    iter->list = NULL;
-    iter->current_node = NULL;
-    iter->snapshot = 0;
+/* Add published slot idx to order[]. Caller holds the order lock. */
+static void segment_order_insert(segment_set_t *seg, unsigned idx)
+{
+    unsigned n = atomic_load_explicit(&seg->order_count, memory_order_relaxed);
+    uint64_t bound = atomic_load_explicit(&seg->bounds[idx], memory_order_relaxed);
+    unsigned pos = segment_order_search(seg, n, bound);
+    for (unsigned j = n; j > pos; j--)
+        atomic_store_explicit(&seg->order[j],
+                              atomic_load_explicit(&seg->order[j - 1], memory_order_relaxed),
+                              memory_order_relaxed);
+    atomic_store_explicit(&seg->order[pos], (uint16_t)idx, memory_order_relaxed);
+    atomic_store_explicit(&seg->order_count, n + 1, memory_order_relaxed);
 }
 
-uint64_t ll_iterator_snapshot(const ll_iterator_t *iter)
+/* Drop slot idx from order[]. Caller holds the order lock. */
+static void segment_order_remove(segment_set_t *seg, unsigned idx)
 {
-    return iter ? iter->snapshot : 0;
+    unsigned n = atomic_load_explicit(&seg->order_count, memory_order_relaxed);
+    unsigned j = 0;
+    while (j < n && atomic_load_explicit(&seg->order[j], memory_order_relaxed) != idx)
+        j++;
+    if (j == n)
+        return;
+    for (; j + 1 < n; j++)
+        atomic_store_explicit(&seg->order[j],
+                              atomic_load_explicit(&seg->order[j + 1], memory_order_relaxed),
+                              memory_order_relaxed);
+    atomic_store_explicit(&seg->order_count, n - 1, memory_order_relaxed);
 }
 
-/* ============== Utility Functions ============== */
+#define ORDER_READ_TRIES 4
 
-bool ll_is_empty(ll_head_t *list)
+/* Generation of a node inserted at insert_txn: 0, or its marker's slot + 1. */
+static unsigned segment_generation(segment_set_t *seg, uint64_t insert_txn)
 {
-    if (!list)
-        return true;
+    for (int tries = 0; tries < ORDER_READ_TRIES; tries++) {
+        unsigned seq = atomic_load_explicit(&seg->order_seq, memory_order_acquire);
+        if (seq & 1) {
+            cpu_relax();
+            continue;
+        }
+        unsigned n = atomic_load_explicit(&seg->order_count, memory_order_relaxed);
+        unsigned pos = segment_order_search(seg, n, insert_txn);
+        unsigned gen = pos < n ? atomic_load_explicit(&seg->order[pos], memory_order_relaxed) + 1u
+                               : 0;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&seg->order_seq, memory_order_relaxed) == seq)
+            return gen;
+    }
 
-    uint64_t snapshot = atomic_load_explicit(&list->commit_id, memory_order_acquire);
-    versioned_node_t *curr = ptr_unmask(
-        atomic_load_explicit(&list->head, memory_order_acquire));
+    /* Writers kept moving it; fall back to scanning every marker. */
+    unsigned used = atomic_load_explicit(&seg->used, memory_order_acquire);
+    unsigned gen = 0;
+    uint64_t best = UINT64_MAX;
+    for (unsigned i = 0; i < used; i++) {
+        versioned_node_t *m = atomic_load_explicit(&seg->markers[i], memory_order_acquire);
+        if (!m || m == MARKER_RESERVED)
+            continue;
+        uint64_t bound = atomic_load_explicit(&seg->bounds[i], memory_order_relaxed);
+        if (bound > insert_txn && bound < best) {
+            best = bound;
+            gen = i + 1;
+        }
+    }
+    return gen;
+}
 
-    while (curr) {
-        if (node_visible(curr, snapshot))
-            return false;
-        curr = ptr_unmask(atomic_load_explicit(&curr->next, memory_order_acquire));
+static void segment_note_tombstone(ll_head_t *list, uint64_t insert_txn)
+{
+    segment_set_t *seg = segments_get(list);
+    if (!seg)
+        return;
+    unsigned gen = segment_generation(seg, insert_txn);
+    /* Release pairs with the reclaimer's take, so it sees the tombstone. */
+    atomic_fetch_add_explicit(&seg->garbage[gen], 1, memory_order_release);
+}
+
+/*
+ * Split the segment after curr, whose successor is next_val. Returns the
+ * new marker's markers[] slot, or -1.
+ */
+static int segment_split(ll_head_t *list, versioned_node_t *curr, uintptr_t next_val)
+{
+    segment_set_t *seg = segments_get_or_create(list);
+    if (!seg)
+        return -1;
+    int idx = segment_slot_reserve(seg);
+    if (idx < 0)
+        return -1;
+
+    versioned_node_t *m = (versioned_node_t *)aligned_alloc(alignof(versioned_node_t),
+                                                            sizeof(versioned_node_t));
+    if (m) {
+        m->user_elm = m;  /* Non-NULL and never a caller's element */
+        m->insert_txn_id = MARKER_TXN;
+        atomic_store_explicit(&m->removed_txn_id, (uint64_t)0, memory_order_relaxed);
+        atomic_store_explicit(&m->next, next_val, memory_order_relaxed);
+        m->retired_next = NULL;
+        if (atomic_compare_exchange_strong_explicit(&curr->next, &next_val, (uintptr_t)m,
+                                                    memory_order_release,
+                                                    memory_order_relaxed)) {
+            atomic_store_explicit(&seg->bounds[idx], curr->insert_txn_id, memory_order_relaxed);
+            atomic_store_explicit(&seg->garbage[idx + 1], 0, memory_order_relaxed);
+            /* Published only once linked, so claimers never start off-chain. */
+            atomic_store_explicit(&seg->markers[idx], m, memory_order_release);
+            segment_order_begin(seg);
+            segment_order_insert(seg, (unsigned)idx);
+            segment_order_end(seg);
+            return idx;
+        }
+        free(m);
     }
-    return true;
+    /* Release only our own reservation. */
+    versioned_node_t *reserved = MARKER_RESERVED;
+    atomic_compare_exchange_strong_explicit(&seg->markers[idx], &reserved, NULL,
+                                            memory_order_release, memory_order_relaxed);
+    return -1;
 }
 
-bool ll_contains(ll_head_t *list, const void *elm)
+/*
+ * Remove marker m, reached through link, merging its segment into the one
+ * before it. On success *next_val is m's successor.
+ */
+static bool segment_merge(segment_set_t *seg, versioned_node_t *m, atomic_uintptr_t *link,
+                          uintptr_t *next_val, ll_thread_state_t *state)
 {
-    if (!list || !elm)
+    unsigned used = atomic_load_explicit(&seg->used, memory_order_acquire);
+    unsigned i = 0;
+    while (i < used && atomic_load_explicit(&seg->markers[i], memory_order_relaxed) != m)
+        i++;
+    if (i == used)
         return false;
+    /* Under the order lock, so a split reusing slot i is ordered after us. */
+    segment_order_begin(seg);
+    versioned_node_t *expected = m;
+    bool taken = atomic_compare_exchange_strong_explicit(&seg->markers[i], &expected, NULL,
+                                                         memory_order_acq_rel,
+                                                         memory_order_relaxed);
+    if (taken)
+        segment_order_remove(seg, i);
+    segment_order_end(seg);
+    if (!taken)
+        return false;
+    /* The caller walks on through the merged nodes and recounts them. */
+    atomic_store_explicit(&seg->garbage[i + 1], 0, memory_order_relaxed);
+
+    /* Retired like a popped node, so its self-pointer never reaches free_cb. */
+    atomic_store_explicit(&m->removed_txn_id, RID_POPPED, memory_order_relaxed);
+    uintptr_t v = next_load(m);
+    while (!(v & NODE_MARK) &&
+           !atomic_compare_exchange_weak_explicit(&m->next, &v, v | NODE_MARK,
+                                                  memory_order_acq_rel,
+                                                  memory_order_acquire))
+        ;
+    if (unlink_node(link, m, v))
+        retire_node(state, m);
+    *next_val = v;
+    return true;
+}
 
-    uint64_t snapshot = atomic_load_explicit(&list->commit_id, memory_order_acquire);
-    versioned_node_t *curr = ptr_unmask(
-        atomic_load_explicit(&list->head, memory_order_acquire));
+/*
+ * Unlink nodes removed before min_snap, and any a pop claimed but could not
+ * unlink itself, from segment idx. Hazard domains walk hand-over-hand and
+ * restart from the segment's marker when a predecessor is removed
+ * underneath them; QSBR domains walk plainly, as do single-slot domains
+ * while list_reclaim() holds their reclaim lock. Tombstones
+ * still visible to a snapshot are counted back into their generation.
+ */
+static unsigned segment_reclaim(ll_head_t *list, segment_set_t *seg, unsigned idx,
+                                uint64_t min_snap, ll_thread_state_t *state)
+{
+    bool plain = state->qsbr || state->hp_count < HP_SLOTS_INTERNAL;
+    unsigned taken = seg ? atomic_exchange_explicit(&seg->garbage[idx], 0u,
+                                                    memory_order_acquire) : 0;
+    unsigned held_total = 0;
 
-    while (curr) {
-        if (node_visible(curr, snapshot) && curr->user_elm == elm)
-            return true;
-        curr = ptr_unmask(atomic_load_explicit(&curr->next, memory_order_acquire));
+    for (;;) {
+        atomic_uintptr_t *link = &list->head;
+        if (idx > 0) {
+            versioned_node_t *start = atomic_load_explicit(&seg->markers[idx - 1],
+                                                           memory_order_acquire);
+            if (start && start != MARKER_RESERVED && !plain) {
+                hp_acquire(state, 1, start);
+                if (atomic_load_explicit(&seg->markers[idx - 1], memory_order_acquire) != start) {
+                    hp_release_all(state);
+                    start = NULL;
+                }
+            }
+            if (!start || start == MARKER_RESERVED) {
+                /* Merged away; its nodes belong to another segment now. */
+                atomic_fetch_add_explicit(&seg->garbage[idx], taken, memory_order_relaxed);
+                return 0;
+            }
+            link = &start->next;
+        }
+
+        versioned_node_t *curr = ptr_unmask(atomic_load_explicit(link, memory_order_acquire));
+        versioned_node_t *placed = NULL;  /* Our own new marker: walk through it */
+        unsigned gen = idx;               /* Generation curr is in */
+        unsigned held = 0;                /* Tombstones kept for a snapshot in gen */
+        size_t run = 0;
+        int slot = 0;
+        bool retry = false;
+
+        while (curr) {
+            if (!plain) {
+                hp_acquire(state, slot, curr);
+                if (atomic_load_explicit(link, memory_order_acquire) != (uintptr_t)curr) {
+                    retry = true;
+                    break;
+                }
+            }
+
+            uintptr_t next_val = next_load(curr);
+            if (node_is_marker(curr) && curr != placed && !(next_val & NODE_MARK)) {
+                if (!seg)
+                    seg = segments_get(list);
+                if (run < SEGMENT_NODES / 4 && segment_merge(seg, curr, link, &next_val, state)) {
+                    curr = ptr_unmask(next_val);
+                    continue;
+                }
+                break;
+            }
+
+            uint64_t rid = atomic_load_explicit(&curr->removed_txn_id, memory_order_acquire);
+            if (rid != 0 && rid >= min_snap && !(next_val & NODE_MARK))
+                held++;
+            if ((next_val & NODE_MARK) || (rid != 0 && rid < min_snap)) {
+                if ((next_val & NODE_MARK) ||
+                    atomic_compare_exchange_strong_explicit(
+                        &curr->next, &next_val, next_val | NODE_MARK,
+                        memory_order_acq_rel, memory_order_acquire)) {
+                    if (unlink_node(link, curr, next_val))
+                        retire_node(state, curr);
+                    curr = ptr_unmask(next_val);
+                }
+                continue;  /* Otherwise curr's successor changed; look again. */
+            }
+
+            if (curr != placed && ++run >= SEGMENT_NODES && next_val) {
+                int split = segment_split(list, curr, next_val);
+                if (split >= 0) {
+                    if (!seg)
+                        seg = segments_get(list);
+                    if (held)
+                        atomic_fetch_add_explicit(&seg->garbage[gen], held,
+                                                  memory_order_relaxed);
+                    held_total += held;
+                    gen = (unsigned)split + 1;
+                    held = 0;
+                    run = 0;
+                    next_val = next_load(curr);
+                    placed = ptr_unmask(next_val);
+                }
+            }
+            link = &curr->next;
+            slot ^= 1;
+            curr = ptr_unmask(next_val);
+        }
+
+        if (!retry) {
+            if (held) {
+                if (!seg)
+                    seg = segments_get(list);
+                if (seg)
+                    atomic_fetch_add_explicit(&seg->garbage[gen], held, memory_order_relaxed);
+            }
+            held_total += held;
+            break;
+        }
     }
-    return false;
+    if (!plain)
+        hp_release_all(state);
+    return held_total;
 }
 
-size_t ll_count(ll_head_t *list)
+/* Next segment for this reclaimer, or -1 once the round is used up. */
+static int segment_claim(segment_set_t *seg, bool first)
 {
-    if (!list)
-        return 0;
-
-    size_t count = 0;
-    uint64_t snapshot = atomic_load_explicit(&list->commit_id, memory_order_acquire);
-    versioned_node_t *curr = ptr_unmask(
-        atomic_load_explicit(&list->head, memory_order_acquire));
-
-    while (curr) {
-        if (node_visible(curr, snapshot))
-            count++;
-        curr = ptr_unmask(atomic_load_explicit(&curr->next, memory_order_acquire));
+    uint64_t claim = atomic_load_explicit(&seg->claim, memory_order_acquire);
+    for (;;) {
+        uint32_t next = (uint32_t)claim;
+        uint64_t desired;
+        int idx;
+        if (next <= atomic_load_explicit(&seg->used, memory_order_acquire)) {
+            desired = claim + 1;
+            idx = (int)next;
+        } else if (first) {
+            desired = (((claim >> 32) + 1) << 32) | 1;  /* New round, segment 0 taken */
+            idx = 0;
+        } else {
+            return -1;
+        }
+        if (atomic_compare_exchange_weak_explicit(&seg->claim, &claim, desired,
+                                                  memory_order_acq_rel,
+                                                  memory_order_acquire))
+            return idx;
     }
-    return count;
 }
 
 /* ============== Memory Reclamation ============== */
 
-void ll_reclaim(ll_head_t *list, void (*free_cb)(void *))
+static void list_reclaim(ll_head_t *list, void (*free_cb)(void *))
 {
     ll_thread_state_t *state = get_tls_thread_state();
     if (!list || !list->domain || !state)
         return;
+    qsbr_quiescent(state);
+    STAT_ADD(state, reclaims, 1);
 
     ll_domain_t *domain = list->domain;
+    stripes_drain(list);
 
-    uint64_t min_snap = min_active_snapshot(domain);
-    if (min_snap == UINT64_MAX)
-        min_snap = atomic_load_explicit(&list->commit_id, memory_order_acquire);
+    size_t holder;
+    uint64_t min_snap = reclaim_horizon(domain, &list->commit_id, &holder);
+    PROBE2(reclaim_start, list, min_snap);
 
-    versioned_node_t *prev = NULL;
-    versioned_node_t *curr = ptr_unmask(
-        atomic_load_explicit(&list->head, memory_order_acquire));
+    /*
+     * A single-slot hazard domain cannot walk hand-over-hand, so its
+     * reclaimers take turns and walk plainly. ll_remove() and
+     * ll_remove_first() are unavailable there, so nothing else unlinks.
+     */
+    bool solo = !state->qsbr && state->hp_count < HP_SLOTS_INTERNAL;
+    if (solo) {
+        backoff_t backoff;
+        backoff_init(&backoff, domain, &state->backoff_seed);
+        while (atomic_flag_test_and_set_explicit(&domain->reclaim_lock,
+                                                  memory_order_acquire))
+            backoff_pause(&backoff);
+    }
 
-    while (curr) {
-        uint64_t rid = atomic_load_explicit(&curr->removed_txn_id, memory_order_acquire);
-        bool reclaimable = (rid != 0 && rid < min_snap);
+    struct ll_list_ext *ext = atomic_load_explicit(&list->ext, memory_order_acquire);
+    segment_set_t *seg = ext ? atomic_load_explicit(&ext->segments, memory_order_acquire) : NULL;
+    unsigned held = 0;
+    if (!seg) {
+        held = segment_reclaim(list, NULL, 0, min_snap, state);
+    } else {
+        bool sweep = atomic_fetch_add_explicit(&seg->passes, 1, memory_order_relaxed) %
+                     GENERATION_SWEEP == 0;
+        for (int idx = segment_claim(seg, true); idx >= 0; idx = segment_claim(seg, false)) {
+            if (sweep || atomic_load_explicit(&seg->garbage[idx], memory_order_relaxed))
+                held += segment_reclaim(list, seg, (unsigned)idx, min_snap, state);
+        }
+    }
+    if (solo)
+        atomic_flag_clear_explicit(&domain->reclaim_lock, memory_order_release);
+    if (held && holder != SIZE_MAX && domain->track_blockers)
+        atomic_fetch_add_explicit(&domain_slot(domain, holder)->snapshot_holds, held,
+                                  memory_order_relaxed);
 
-        uintptr_t next_val = atomic_load_explicit(&curr->next, memory_order_acquire);
-        versioned_node_t *next = ptr_unmask(next_val);
+    /* Try to free retired nodes. */
+    size_t freed = retired_scan(domain, state, free_cb, false);
+    PROBE3(reclaim_done, list, min_snap, freed);
+}
 
-        if (reclaimable) {
-            hp_acquire(state, 0, curr);
-            uintptr_t unlink_val = (uintptr_t)curr;
-            bool unlinked = false;
-
-            if (prev) {
-                if (atomic_compare_exchange_weak_explicit(
-                        &prev->next, &unlink_val, next_val,
-                        memory_order_release, memory_order_acquire))
-                    unlinked = true;
-            } else {
-                if (atomic_compare_exchange_weak_explicit(
-                        &list->head, &unlink_val, next_val,
-                        memory_order_release, memory_order_acquire))
-                    unlinked = true;
-            }
+void ll_reclaim(ll_head_t *list, void (*free_cb)(void *))
+{
+    HIST_BEGIN();
+    uint64_t trace_start = trace_op_begin();
+    list_reclaim(list, free_cb);
+    trace_op_end(LL_OP_RECLAIM, list, trace_start);
+    HIST_END(LL_OP_RECLAIM);
+}
 
-            if (unlinked) {
-                hp_release(state, 0);
-                /* Add to retired list. */
-                atomic_store_explicit(&curr->next, (uintptr_t)state->retired_list,
-                                      memory_order_relaxed);
-                state->retired_list = curr;
-                curr = next;
-                continue;
-            }
-            hp_release(state, 0);
-        }
+/* ============== Caller Hazard Pointers ============== */
 
-        prev = curr;
-        curr = next;
-    }
+int ll_hazard_reserve(ll_domain_t *domain, unsigned count)
+{
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (!domain || count == 0)
+        return LL_ERR_INVAL;
+    if (!state || get_tls_domain() != domain)
+        return LL_ERR_NOTHREAD;
+    if (state->hp_reserved + count > state->hp_count)
+        return LL_ERR_FULL;
 
-    /* Try to free retired nodes. */
-    versioned_node_t *still_held = NULL;
-    while (state->retired_list) {
-        versioned_node_t *n = state->retired_list;
-        state->retired_list = ptr_unmask(
-            atomic_load_explicit(&n->next, memory_order_relaxed));
-
-        if (any_hp_equals(domain, n)) {
-            atomic_store_explicit(&n->next, (uintptr_t)still_held, memory_order_relaxed);
-            still_held = n;
-        } else {
-            void *user = n->user_elm;
-            free(n);
-            if (free_cb)
-                free_cb(user);
-        }
-    }
-    state->retired_list = still_held;
+    int first = (int)state->hp_reserved;
+    state->hp_reserved += count;
+    return first;
+}
+
+void ll_hazard_unreserve(ll_domain_t *domain, int first)
+{
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (!domain || !state || get_tls_domain() != domain)
+        return;
+    if (first < HP_SLOTS_INTERNAL || (unsigned)first >= state->hp_reserved)
+        return;
+
+    for (unsigned i = (unsigned)first; i < state->hp_reserved; i++)
+        atomic_store_explicit(&state->hazard_ptrs[i], NULL, memory_order_release);
+    state->hp_reserved = (unsigned)first;
+}
+
+int ll_hazard_set(ll_domain_t *domain, int slot, const void *p)
+{
+    ll_thread_state_t *state = get_tls_thread_state();
+    if (!domain || !state || get_tls_domain() != domain)
+        return LL_ERR_NOTHREAD;
+    if (slot < HP_SLOTS_INTERNAL || (unsigned)slot >= state->hp_reserved)
+        return LL_ERR_INVAL;
+
+    atomic_store_explicit(&state->hazard_ptrs[slot], (void *)p, memory_order_release);
+    light_fence(state->asym_fences);
+    return LL_OK;
+}
+
+void ll_hazard_clear(ll_domain_t *domain, int slot)
+{
+    ll_hazard_set(domain, slot, NULL);
 }
 
 /* ============== Legacy API (Deprecated) ============== */
@@ -770,8 +4549,10 @@ static ll_domain_t *get_legacy_domain(void)
     if (domain)
         return domain;
 
+    backoff_t backoff;
+    backoff_init(&backoff, NULL, NULL);
     while (atomic_flag_test_and_set_explicit(&legacy_init_lock, memory_order_acquire)) {
-        /* Spin. */
+        backoff_pause(&backoff);
     }
 
     /* Re-check after acquiring lock. */
@@ -815,13 +4596,19 @@ void ll_insert_head_(atomic_uintptr_t *head, ll_commit_id_t *commit_id, void *el
     w->insert_txn_id = txn_id;
     atomic_store_explicit(&w->removed_txn_id, (uint64_t)0, memory_order_release);
 
-    uintptr_t old_head;
-    do {
-        old_head = atomic_load_explicit(head, memory_order_acquire);
+    ll_thread_state_t *state = get_tls_thread_state();
+    backoff_t backoff;
+    backoff_init(&backoff, state ? state->domain : NULL,
+                 state ? &state->backoff_seed : NULL);
+    uintptr_t old_head = atomic_load_explicit(head, memory_order_acquire);
+    for (;;) {
         atomic_store_explicit(&w->next, old_head, memory_order_release);
-    } while (!atomic_compare_exchange_weak_explicit(
-        head, &old_head, (uintptr_t)w,
-        memory_order_release, memory_order_acquire));
+        if (atomic_compare_exchange_weak_explicit(
+                head, &old_head, (uintptr_t)w,
+                memory_order_release, memory_order_acquire))
+            break;
+        backoff_pause(&backoff);
+    }
 }
 
 void *ll_remove_head_(atomic_uintptr_t *head, ll_commit_id_t *commit_id)
@@ -833,67 +4620,10 @@ void *ll_remove_head_(atomic_uintptr_t *head, ll_commit_id_t *commit_id)
         return NULL;
     uint64_t snapshot = atomic_load_explicit(commit_id, memory_order_acquire);
 
-    for (;;) {
-        uintptr_t head_val = atomic_load_explicit(head, memory_order_acquire);
-        versioned_node_t *w = ptr_unmask(head_val);
-        if (!w)
-            return NULL;
-
-        hp_acquire(state, 0, w);
-
-        if (atomic_load_explicit(head, memory_order_acquire) != head_val) {
-            hp_release(state, 0);
-            continue;
-        }
-
-        if (node_visible(w, snapshot)) {
-            uintptr_t next_val = atomic_load_explicit(&w->next, memory_order_acquire);
-            if (atomic_compare_exchange_weak_explicit(
-                    head, &head_val, next_val,
-                    memory_order_release, memory_order_acquire)) {
-                void *user = w->user_elm;
-                hp_release(state, 0);
-                free(w);
-                return user;
-            }
-            hp_release(state, 0);
-            continue;
-        }
-
-        /* Head not visible, find first visible. */
-        versioned_node_t *prev = w;
-        versioned_node_t *curr = ptr_unmask(
-            atomic_load_explicit(&w->next, memory_order_acquire));
-        bool cas_failed = false;
-
-        while (curr) {
-            hp_acquire(state, 1, curr);
-
-            if (node_visible(curr, snapshot)) {
-                uintptr_t next_val = atomic_load_explicit(&curr->next, memory_order_acquire);
-                uintptr_t prev_next = (uintptr_t)curr;
-
-                if (atomic_compare_exchange_weak_explicit(
-                        &prev->next, &prev_next, next_val,
-                        memory_order_release, memory_order_acquire)) {
-                    void *user = curr->user_elm;
-                    hp_release_all(state);
-                    free(curr);
-                    return user;
-                }
-                cas_failed = true;
-                break;
-            }
-
-            prev = curr;
-            curr = ptr_unmask(atomic_load_explicit(&curr->next, memory_order_acquire));
-        }
-
-        hp_release_all(state);
-        if (cas_failed)
-            continue;
+    void *user = NULL;
+    if (list_pop_first(head, snapshot, state->domain, state, NULL, &user) != LL_OK)
         return NULL;
-    }
+    return user;
 }
 
 int ll_remove_(atomic_uintptr_t *head, ll_commit_id_t *commit_id,
@@ -908,58 +4638,18 @@ int ll_remove_(atomic_uintptr_t *head, ll_commit_id_t *commit_id,
 
     uint64_t txn_id = atomic_fetch_add_explicit(commit_id, 1, memory_order_acq_rel);
 
-    versioned_node_t *curr = ptr_unmask(
-        atomic_load_explicit(head, memory_order_acquire));
-
-    while (curr) {
-        hp_acquire(state, 0, curr);
-
-        /* Re-check that curr is still in list. */
-        bool valid = false;
-        versioned_node_t *scan = ptr_unmask(
-            atomic_load_explicit(head, memory_order_acquire));
-        while (scan) {
-            if (scan == curr) {
-                valid = true;
-                break;
-            }
-            scan = ptr_unmask(atomic_load_explicit(&scan->next, memory_order_acquire));
-        }
-
-        if (!valid) {
-            hp_release(state, 0);
-            curr = ptr_unmask(atomic_load_explicit(head, memory_order_acquire));
-            continue;
-        }
-
-        if (curr->user_elm == elm) {
-            atomic_store_explicit(&curr->removed_txn_id, txn_id, memory_order_release);
-            hp_release(state, 0);
-            return 0;
-        }
-
-        versioned_node_t *next = ptr_unmask(
-            atomic_load_explicit(&curr->next, memory_order_acquire));
-        hp_release(state, 0);
-        curr = next;
-    }
-
-    return -1;
+    uint64_t insert_txn_id;
+    return remove_walk(head, elm, txn_id, state, &insert_txn_id) ? 0 : -1;
 }
 
 uint64_t ll_snapshot_begin(ll_commit_id_t *commit_id)
 {
     ensure_legacy_thread_registered();
 
-    uint64_t snapshot = atomic_load_explicit(commit_id, memory_order_acquire);
-
     ll_thread_state_t *state = get_tls_thread_state();
-    if (state) {
-        atomic_store_explicit(&state->active_snapshot, snapshot,
-                              memory_order_release);
-    }
-
-    return snapshot;
+    if (state)
+        return snapshot_publish(state, commit_id);
+    return atomic_load_explicit(commit_id, memory_order_acquire);
 }
 
 void ll_snapshot_end(void)
@@ -993,8 +4683,7 @@ void *ll_snapshot_first_(atomic_uintptr_t *head, ll_commit_id_t *commit_id,
             return curr->user_elm;
         }
 
-        versioned_node_t *next = ptr_unmask(
-            atomic_load_explicit(&curr->next, memory_order_acquire));
+        versioned_node_t *next = ptr_unmask(next_load(curr));
         if (state)
             hp_release(state, 0);
         curr = next;
@@ -1021,7 +4710,7 @@ void *ll_snapshot_next_(atomic_uintptr_t *head, ll_commit_id_t *commit_id,
 
         if (curr->user_elm == elm) {
             /* Found it, now find next visible. */
-            curr = ptr_unmask(atomic_load_explicit(&curr->next, memory_order_acquire));
+            curr = ptr_unmask(next_load(curr));
             if (state)
                 hp_release(state, 0);
 
@@ -1035,8 +4724,7 @@ void *ll_snapshot_next_(atomic_uintptr_t *head, ll_commit_id_t *commit_id,
                     return curr->user_elm;
                 }
 
-                versioned_node_t *next = ptr_unmask(
-                    atomic_load_explicit(&curr->next, memory_order_acquire));
+                versioned_node_t *next = ptr_unmask(next_load(curr));
                 if (state)
                     hp_release(state, 0);
                 curr = next;
@@ -1044,8 +4732,7 @@ void *ll_snapshot_next_(atomic_uintptr_t *head, ll_commit_id_t *commit_id,
             return NULL;
         }
 
-        versioned_node_t *next = ptr_unmask(
-            atomic_load_explicit(&curr->next, memory_order_acquire));
+        versioned_node_t *next = ptr_unmask(next_load(curr));
         if (state)
             hp_release(state, 0);
         curr = next;
@@ -1064,71 +4751,12 @@ void ll_reclaim_(atomic_uintptr_t *head, ll_commit_id_t *commit_id,
 
     ll_domain_t *domain = get_legacy_domain();
 
-    uint64_t min_snap = min_active_snapshot(domain);
-    if (min_snap == UINT64_MAX)
-        min_snap = atomic_load_explicit(commit_id, memory_order_acquire);
-
-    versioned_node_t *prev = NULL;
-    versioned_node_t *curr = ptr_unmask(
-        atomic_load_explicit(head, memory_order_acquire));
-
-    while (curr) {
-        uint64_t rid = atomic_load_explicit(&curr->removed_txn_id, memory_order_acquire);
-        bool reclaimable = (rid != 0 && rid < min_snap);
-
-        uintptr_t next_val = atomic_load_explicit(&curr->next, memory_order_acquire);
-        versioned_node_t *next = ptr_unmask(next_val);
-
-        if (reclaimable) {
-            hp_acquire(state, 0, curr);
-            uintptr_t unlink_val = (uintptr_t)curr;
-            bool unlinked = false;
-
-            if (prev) {
-                if (atomic_compare_exchange_weak_explicit(
-                        &prev->next, &unlink_val, next_val,
-                        memory_order_release, memory_order_acquire))
-                    unlinked = true;
-            } else {
-                if (atomic_compare_exchange_weak_explicit(
-                        head, &unlink_val, next_val,
-                        memory_order_release, memory_order_acquire))
-                    unlinked = true;
-            }
-
-            if (unlinked) {
-                hp_release(state, 0);
-                atomic_store_explicit(&curr->next, (uintptr_t)state->retired_list,
-                                      memory_order_relaxed);
-                state->retired_list = curr;
-                curr = next;
-                continue;
-            }
-            hp_release(state, 0);
-        }
+    uint64_t min_snap = reclaim_horizon(domain, commit_id, NULL);
 
-        prev = curr;
-        curr = next;
-    }
+    reclaim_unlink(head, min_snap, state);
 
     /* Free retired nodes. */
-    versioned_node_t *still_held = NULL;
-    while (state->retired_list) {
-        versioned_node_t *n = state->retired_list;
-        state->retired_list = ptr_unmask(
-            atomic_load_explicit(&n->next, memory_order_relaxed));
-
-        if (any_hp_equals(domain, n)) {
-            atomic_store_explicit(&n->next, (uintptr_t)still_held, memory_order_relaxed);
-            still_held = n;
-        } else {
-            void *user = n->user_elm;
-            free(n);
-            if (free_cb)
-                free_cb(user);
-        }
-    }
-    state->retired_list = still_held;
+    retired_scan(domain, state, free_cb, false);
 }
 
 /* ============== Legacy Iterator API ============== */
@@ -1140,15 +4768,14 @@ void ll_legacy_iter_begin(ll_legacy_iter_t *iter, atomic_uintptr_t *head,
 
     iter->head = head;
     iter->commit_id = commit_id;
-    iter->snapshot = atomic_load_explicit(commit_id, memory_order_acquire);
     iter->current_node = NULL;
 
     /* Record snapshot in thread state for reclamation safety. */
     ll_thread_state_t *state = get_tls_thread_state();
-    if (state) {
-        atomic_store_explicit(&state->active_snapshot, iter->snapshot,
-                              memory_order_release);
-    }
+    if (state)
+        iter->snapshot = snapshot_publish(state, commit_id);
+    else
+        iter->snapshot = atomic_load_explicit(commit_id, memory_order_acquire);
 }
 
 void *ll_legacy_iter_next(ll_legacy_iter_t *iter)
@@ -1162,7 +4789,7 @@ void *ll_legacy_iter_next(ll_legacy_iter_t *iter)
     } else {
         /* Subsequent calls: continue from where we left off. */
         versioned_node_t *prev = (versioned_node_t *)iter->current_node;
-        curr = ptr_unmask(atomic_load_explicit(&prev->next, memory_order_acquire));
+        curr = ptr_unmask(next_load(prev));
     }
 
     /* Find next visible node. */
@@ -1177,8 +4804,7 @@ void *ll_legacy_iter_next(ll_legacy_iter_t *iter)
             return curr->user_elm;
         }
 
-        versioned_node_t *next = ptr_unmask(
-            atomic_load_explicit(&curr->next, memory_order_acquire));
+        versioned_node_t *next = ptr_unmask(next_load(curr));
         if (state)
             hp_release(state, 0);
         curr = next;
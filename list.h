@@ -29,6 +29,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,6 +43,8 @@ extern "C" {
 #define LL_ERR_NOTHREAD -3  /* Thread not registered */
 #define LL_ERR_INVAL   -4   /* Invalid argument */
 #define LL_ERR_FULL    -5   /* Resource limit reached */
+#define LL_ERR_TIMEDOUT -6  /* Timed out waiting */
+#define LL_ERR_NOTSUP  -7   /* Not built into this library */
 
 /* ============== Types ============== */
 
@@ -56,8 +59,204 @@ typedef struct ll_head {
     atomic_uintptr_t head;      /* Pointer to first versioned_node */
     ll_commit_id_t commit_id;   /* Monotonic transaction counter */
     ll_domain_t *domain;        /* Associated hazard pointer domain */
+    _Atomic(struct ll_list_ext *) ext; /* Internal: optional per-list state */
+    _Atomic uint32_t contention; /* Internal: decaying head CAS failure score */
 } ll_head_t;
 
+/* List flags for ll_init_ex(). */
+#define LL_LIST_COMBINING   0x1u /* Flat-combine ll_insert_head()/ll_remove_first() */
+#define LL_LIST_ELIMINATION 0x2u /* Pair colliding inserts and remove_first calls */
+#define LL_LIST_STRIPED     0x4u /* Start with insert stripes inflated */
+#define LL_LIST_PERCPU      0x8u /* Buffer inserts per CPU, merge on read */
+#define LL_LIST_WAITFREE    0x10u /* ll_insert_head() is one atomic exchange */
+
+/* List configuration for ll_init_ex(). */
+typedef struct ll_list_config {
+    unsigned flags;             /* LL_LIST_* flags (0 = plain list) */
+    const char *labels;         /* Prometheus labels, e.g. name="jobs",shard="2" (NULL = none) */
+} ll_list_config_t;
+
+/*
+ * Backoff applied between failed CAS attempts in a domain's retry loops.
+ *
+ * LL_BACKOFF_AUTO picks per operation from the number of registered
+ * threads: no backoff for a single thread, exponential while threads fit
+ * on the online CPUs, randomized once they are oversubscribed.
+ */
+typedef enum ll_backoff {
+    LL_BACKOFF_AUTO = 0,        /* Contention-aware default */
+    LL_BACKOFF_NONE,            /* Retry immediately */
+    LL_BACKOFF_EXPONENTIAL,     /* Pause, doubling up to a cap */
+    LL_BACKOFF_RANDOM           /* Random pause below a doubling cap */
+} ll_backoff_t;
+
+/*
+ * How hazard pointers and snapshots are published against reclamation.
+ *
+ * LL_FENCE_AUTO uses asymmetric fences when the kernel supports
+ * membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED). Readers then publish with
+ * plain stores and a compiler barrier, and reclaimers pay a process-wide
+ * barrier instead. Otherwise, and with LL_FENCE_SYMMETRIC, every
+ * publication is followed by a full fence.
+ */
+typedef enum ll_fence {
+    LL_FENCE_AUTO = 0,          /* Asymmetric when available */
+    LL_FENCE_SYMMETRIC          /* Full fence on every publication */
+} ll_fence_t;
+
+/*
+ * How read-only traversals (iterators, ll_contains(), ll_count(),
+ * ll_is_empty()) are protected against reclamation.
+ *
+ * LL_READ_HAZARD publishes a hazard pointer for every node visited.
+ * LL_READ_QSBR (quiescent-state-based reclamation) visits nodes with no
+ * per-node stores: each registered thread instead announces a quiescent
+ * state at the start of every list operation outside an iterator, and
+ * retired nodes are freed only once every registered thread has announced
+ * one since they were retired. Threads that stay registered without
+ * calling into the library must call ll_domain_quiescent() periodically,
+ * or reclamation stalls.
+ */
+typedef enum ll_read_mode {
+    LL_READ_HAZARD = 0,         /* Hazard pointer per visited node */
+    LL_READ_QSBR                /* Quiescent states, no per-node stores */
+} ll_read_mode_t;
+
+/* Domain configuration for ll_domain_create_ex(). Zero fields select defaults. */
+typedef struct ll_domain_config {
+    size_t initial_threads;     /* Initial capacity for threads (0 = 16) */
+    unsigned hp_slots;          /* Hazard pointer slots per thread (0 = 2, max 64) */
+    ll_backoff_t backoff;       /* CAS retry backoff (0 = LL_BACKOFF_AUTO) */
+    ll_fence_t fences;          /* Publication fences (0 = LL_FENCE_AUTO) */
+    ll_read_mode_t read_mode;   /* Read-side protection (0 = LL_READ_HAZARD) */
+    size_t trace_events;        /* Trace ring events per thread (0 = off, max 2^24) */
+    bool track_blockers;        /* Record who holds back ll_reclaim() (see ll_domain_top_blockers()) */
+    bool track_contention;      /* Keep per-list heat counters (see ll_domain_top_contended()) */
+} ll_domain_config_t;
+
+/*
+ * Operation counters summed over a domain's thread slots by
+ * ll_domain_stats(). Slots keep their counts when threads unregister, so
+ * totals cover every thread that ever used the domain. nodes_visited
+ * divided by lookups + iterations gives the average traversal length.
+ */
+typedef struct ll_stats {
+    uint64_t inserts;           /* ll_insert_head() calls */
+    uint64_t removes;           /* ll_remove() calls */
+    uint64_t remove_firsts;     /* ll_remove_first() calls */
+    uint64_t lookups;           /* ll_contains(), ll_count(), ll_is_empty() and ll_list_health() calls */
+    uint64_t iterations;        /* ll_iterator_begin() calls */
+    uint64_t reclaims;          /* ll_reclaim() calls */
+    uint64_t insert_retries;    /* Failed head CASes in ll_insert_head() */
+    uint64_t remove_first_retries; /* Restarted walks in ll_remove_first() */
+    uint64_t nodes_visited;     /* Nodes walked by lookups and iterators */
+    uint64_t nodes_skipped;     /* Of those, nodes not visible at their snapshot */
+    uint64_t reclaim_passes;    /* Scans of a thread's retired nodes */
+    uint64_t nodes_freed;       /* Retired nodes freed by those scans */
+    uint64_t nodes_held;        /* Retired nodes a scan kept for a hazard pointer */
+} ll_stats_t;
+
+/* Operations timed by LL_HISTOGRAMS builds. */
+typedef enum ll_op {
+    LL_OP_INSERT = 0,           /* ll_insert_head() */
+    LL_OP_REMOVE,               /* ll_remove() */
+    LL_OP_REMOVE_FIRST,         /* ll_remove_first(), each attempt of _wait() */
+    LL_OP_ITERATE,              /* ll_iterator_begin() to ll_iterator_end() */
+    LL_OP_RECLAIM,              /* ll_reclaim() */
+    LL_OP_COUNT
+} ll_op_t;
+
+/*
+ * Latency histogram in nanoseconds. Bucket i holds exact value i below 8;
+ * above that each power of two is split into 8 equal buckets, so bucket
+ * widths stay within 12.5% of the values they hold. The last bucket also
+ * holds everything from 2^34 ns up.
+ */
+#define LL_HIST_BUCKETS 256
+
+typedef struct ll_histogram {
+    uint64_t count;             /* Samples */
+    uint64_t sum_ns;            /* Sum of all samples */
+    uint64_t max_ns;            /* Largest sample */
+    uint64_t buckets[LL_HIST_BUCKETS];
+} ll_histogram_t;
+
+/*
+ * Chain composition reported by ll_list_health(). Tombstones are removed
+ * nodes that ll_reclaim() has not unlinked yet; invisible nodes also
+ * include inserts not yet visible at commit_id. Segment markers placed by
+ * ll_reclaim() are counted apart from nodes.
+ */
+typedef struct ll_list_health {
+    uint64_t commit_id;         /* Snapshot the chain was judged at */
+    size_t nodes;               /* Nodes in the chain */
+    size_t tombstones;          /* Of those, removed nodes */
+    size_t invisible;           /* Of those, nodes not visible at commit_id */
+    size_t longest_invisible_run; /* Most invisible nodes in a row */
+    size_t markers;             /* Reclaim segment markers */
+    double tombstone_ratio;     /* tombstones / nodes (0 for an empty chain) */
+} ll_list_health_t;
+
+/* Reclamation state of one thread slot, from ll_domain_health(). */
+typedef struct ll_thread_health {
+    bool in_use;                /* A thread holds the slot */
+    uint64_t active_snapshot;   /* Snapshot it holds open (0 = none) */
+    size_t retired;             /* Nodes it retired that are not yet freed */
+    size_t hazard_held;         /* Of those, nodes its last scan kept for a hazard */
+} ll_thread_health_t;
+
+/*
+ * Reclamation state of a domain, from ll_domain_health(). Slot indexes
+ * are SIZE_MAX when no slot qualifies.
+ */
+typedef struct ll_domain_health {
+    size_t threads;             /* Registered threads */
+    size_t slots;               /* Thread slots, registered or free */
+    size_t retired;             /* Retired nodes not yet freed, orphans included */
+    size_t orphans;             /* Of those, nodes handed off by departed threads */
+    size_t retired_max;         /* Largest single slot backlog */
+    size_t retired_max_slot;    /* Slot holding it */
+    size_t hazard_held;         /* Nodes the last scan of each slot kept for hazards */
+    uint64_t oldest_snapshot;   /* Oldest snapshot held open (0 = none) */
+    size_t oldest_snapshot_slot; /* Slot holding it */
+} ll_domain_health_t;
+
+/*
+ * Heat counters of one list in a domain created with track_contention,
+ * from ll_domain_top_contended(). Counts run from ll_init().
+ */
+typedef struct ll_list_heat {
+    ll_head_t *list;            /* The list */
+    const char *labels;         /* Its ll_init_ex() labels, NULL if none (valid until ll_destroy()) */
+    uint64_t cas_failures;      /* Failed head CASes in ll_insert_head() */
+    uint64_t commits;           /* Transaction ids taken (commit_id - 1) */
+    uint32_t readers;           /* Traversals in progress */
+    uint32_t readers_max;       /* Most traversals seen in progress at once */
+} ll_list_heat_t;
+
+/* Longest thread name kept by ll_thread_set_name(), NUL included. */
+#define LL_THREAD_NAME_MAX 32
+
+/*
+ * A thread slot that held back reclamation, from ll_domain_top_blockers().
+ * Counts accumulate from domain creation, or the last
+ * ll_domain_blockers_reset(), until the slot's thread unregisters.
+ */
+typedef struct ll_blocker {
+    size_t slot;                /* Thread slot index */
+    char name[LL_THREAD_NAME_MAX]; /* ll_thread_set_name() name, or empty */
+    uint64_t active_snapshot;   /* Snapshot it holds open now (0 = none) */
+    uint64_t snapshot_holds;    /* Tombstones ll_reclaim() left because this
+                                   slot held the oldest snapshot */
+    uint64_t hazard_holds;      /* Retired nodes kept for its hazard pointers */
+} ll_blocker_t;
+
+/* Output formats of ll_debug_analyze(). */
+typedef enum ll_analyze_format {
+    LL_ANALYZE_TEXT = 0,        /* Human-readable report */
+    LL_ANALYZE_JSON             /* One JSON object */
+} ll_analyze_format_t;
+
 /* Iterator for efficient traversal (avoids O(N²) issue). */
 typedef struct ll_iterator {
     ll_head_t *list;            /* List being traversed */
@@ -76,6 +275,204 @@ typedef struct ll_iterator {
  */
 ll_domain_t *ll_domain_create(size_t initial_threads);
 
+/*
+ * Create a hazard pointer domain with explicit configuration.
+ *
+ * hp_slots sets how many hazard pointers each thread can publish. List
+ * operations use the first two; any beyond that can be reserved by callers
+ * with ll_hazard_reserve(). A domain with a single slot suits read-only
+ * users and makes reclamation scans cheaper, but ll_remove_first() then
+ * returns LL_ERR_FULL, as does ll_remove() outside LL_READ_QSBR.
+ *
+ * trace_events gives every thread slot a ring of that many trace events
+ * (rounded up to a power of two) for ll_trace_dump().
+ *
+ * @param config  Domain configuration (must not be NULL)
+ * @return Domain pointer on success, NULL on allocation failure, if
+ *         hp_slots exceeds 64, if backoff is not a valid policy or if
+ *         trace_events exceeds 2^24
+ */
+ll_domain_t *ll_domain_create_ex(const ll_domain_config_t *config);
+
+/*
+ * Get the number of hazard pointer slots per thread in a domain.
+ *
+ * @param domain  Domain to query
+ * @return Slots per thread, or 0 if domain is NULL
+ */
+unsigned ll_domain_hp_slots(const ll_domain_t *domain);
+
+/*
+ * Check whether a domain publishes hazards and snapshots with asymmetric
+ * (membarrier-based) fences.
+ *
+ * @param domain  Domain to query
+ * @return true if asymmetric fences are in use
+ */
+bool ll_domain_asymmetric_fences(const ll_domain_t *domain);
+
+/*
+ * Announce a quiescent state for the calling thread in an LL_READ_QSBR
+ * domain: the thread holds no node or element obtained from any list in
+ * the domain. Event loops call this once per iteration, and before
+ * blocking. Does nothing in LL_READ_HAZARD domains or inside an iterator.
+ *
+ * @param domain  Domain the calling thread is registered with
+ */
+void ll_domain_quiescent(ll_domain_t *domain);
+
+/*
+ * Sum the operation counters of every thread slot in a domain. Counters
+ * are only kept when the library is built with LL_STATS. Threads keep
+ * running; each counter is read once, so the totals are not a consistent
+ * snapshot across counters.
+ *
+ * @param domain  Domain to query
+ * @param out     Receives the totals (zeroed if stats are not built in)
+ * @return LL_OK on success, LL_ERR_INVAL if an argument is NULL,
+ *         LL_ERR_NOTSUP if the library was built without LL_STATS
+ */
+int ll_domain_stats(const ll_domain_t *domain, ll_stats_t *out);
+
+/*
+ * Report a domain's reclamation backlog: retired nodes waiting per thread
+ * slot, how many of them the last scans found protected by hazard
+ * pointers, and the oldest snapshot holding reclamation back. Reads a few
+ * counters per slot without locking, so it is cheap enough to poll while
+ * threads run; the figures are not a consistent snapshot across slots.
+ *
+ * @param domain       Domain to query
+ * @param out          Receives the domain totals
+ * @param threads      Receives per-slot state for the first max_threads
+ *                     slots, in slot order (may be NULL if max_threads is 0)
+ * @param max_threads  Capacity of threads; out->slots gives the count needed
+ * @return LL_OK on success, LL_ERR_INVAL if domain or out is NULL, or
+ *         threads is NULL with max_threads nonzero
+ */
+int ll_domain_health(const ll_domain_t *domain, ll_domain_health_t *out,
+                     ll_thread_health_t *threads, size_t max_threads);
+
+/*
+ * Report the thread slots that most held back reclamation in a domain
+ * created with track_blockers, heaviest first. Each ll_reclaim() that
+ * leaves tombstones for a snapshot charges them to the slot holding the
+ * oldest one, and each node a retired scan keeps is charged to the first
+ * slot whose hazard pointer holds it. Only slots with a nonzero count
+ * are reported.
+ *
+ * @param domain  Domain to query
+ * @param out     Array of k entries to fill
+ * @param k       Most entries to report
+ * @return Number of entries filled (0 if nothing was charged or the
+ *         domain does not track blockers), LL_ERR_INVAL if domain is NULL
+ *         or out is NULL with k nonzero
+ */
+int ll_domain_top_blockers(const ll_domain_t *domain, ll_blocker_t *out, size_t k);
+
+/*
+ * Zero the blocker counts of every slot in a domain, e.g. before a
+ * reclaim whose blockers are wanted.
+ *
+ * @param domain  Domain to reset
+ * @return LL_OK on success, LL_ERR_INVAL if domain is NULL
+ */
+int ll_domain_blockers_reset(ll_domain_t *domain);
+
+/*
+ * Report the hottest lists of a domain created with track_contention:
+ * most failed head CASes first, then most commits. Every list in such a
+ * domain counts the CASes its inserts lose, and the traversals
+ * (iterators, ll_contains(), ll_count(), ll_is_empty(),
+ * ll_list_health()) running on it at once, which costs two atomic adds
+ * per traversal on a line of its own. Lists that saw no activity are not
+ * reported. ll_destroy() waits for a report in progress.
+ *
+ * @param domain  Domain to query
+ * @param out     Array of k entries to fill
+ * @param k       Most entries to report
+ * @return Number of entries filled (0 if the domain does not track
+ *         contention), LL_ERR_INVAL if domain is NULL or out is NULL with
+ *         k nonzero
+ */
+int ll_domain_top_contended(const ll_domain_t *domain, ll_list_heat_t *out, size_t k);
+
+/*
+ * Snapshot a domain's latency histograms, one per ll_op_t, merged over
+ * every thread slot. Latencies are only recorded when the library is
+ * built with LL_HISTOGRAMS; threads keep running while they are read.
+ *
+ * @param domain  Domain to query
+ * @param out     Array of LL_OP_COUNT histograms to fill (zeroed if
+ *                histograms are not built in)
+ * @return LL_OK on success, LL_ERR_INVAL if an argument is NULL,
+ *         LL_ERR_NOTSUP if the library was built without LL_HISTOGRAMS
+ */
+int ll_domain_histograms(const ll_domain_t *domain, ll_histogram_t out[LL_OP_COUNT]);
+
+/*
+ * Reset a domain's latency histograms. Each thread clears its own on its
+ * next recorded operation; until then snapshots leave it out.
+ *
+ * @param domain  Domain to reset
+ * @return LL_OK on success, LL_ERR_INVAL if domain is NULL,
+ *         LL_ERR_NOTSUP if the library was built without LL_HISTOGRAMS
+ */
+int ll_domain_histograms_reset(ll_domain_t *domain);
+
+/*
+ * Write the trace rings of a domain created with trace_events as Chrome
+ * trace-event JSON, which chrome://tracing and Perfetto open directly.
+ * Each thread slot is one track, holding its most recent operations
+ * (insert, remove, remove_first, iterate, reclaim) as spans, plus instants
+ * for CAS retries, node retires and the frees of each reclaim scan.
+ * Threads keep running; events overwritten during the dump are left out.
+ * The rings are not consumed. A domain without tracing writes an empty
+ * trace.
+ *
+ * @param domain  Domain to dump
+ * @param out     Stream to write to
+ * @return LL_OK on success, LL_ERR_INVAL if an argument is NULL or
+ *         writing to out failed
+ */
+int ll_trace_dump(const ll_domain_t *domain, FILE *out);
+
+/*
+ * Render a domain's metrics in the Prometheus text exposition format:
+ * thread and reclamation gauges from ll_domain_health(), the LL_STATS
+ * counters and LL_HISTOGRAMS latency histograms when built in, and
+ * per-list series for every live list initialized with labels, tagged
+ * with those labels. Like snprintf(), writes at most len bytes including
+ * the terminating NUL and returns the length of the full output, so a
+ * return value of len or more means buf was too small. Safe to call from
+ * any thread, registered or not, while the domain is in use.
+ *
+ * @param domain  Domain to export
+ * @param buf     Output buffer (may be NULL if len is 0)
+ * @param len     Size of buf
+ * @return Length of the full output excluding the NUL, LL_ERR_INVAL if
+ *         domain is NULL or buf is NULL with len nonzero
+ */
+int ll_stats_format_prometheus(const ll_domain_t *domain, char *buf, size_t len);
+
+/*
+ * Add the samples of src to dst, e.g. to combine snapshots of several
+ * domains.
+ *
+ * @param dst  Histogram to add to
+ * @param src  Histogram to add
+ */
+void ll_histogram_merge(ll_histogram_t *dst, const ll_histogram_t *src);
+
+/*
+ * Estimate a percentile from a histogram: the upper edge of the bucket
+ * holding the nearest-rank sample, capped at max_ns.
+ *
+ * @param h    Histogram to read
+ * @param pct  Percentile in [0, 100], e.g. 99.9
+ * @return Latency in nanoseconds, or 0 if h is NULL or empty
+ */
+uint64_t ll_histogram_percentile(const ll_histogram_t *h, double pct);
+
 /*
  * Destroy a hazard pointer domain. All lists using this domain must be
  * destroyed first, and all threads must be unregistered.
@@ -86,7 +483,9 @@ void ll_domain_destroy(ll_domain_t *domain);
 
 /*
  * Register the current thread with a domain. Must be called before
- * using any list operations on lists in this domain.
+ * using any list operations on lists in this domain. Reuses a released
+ * slot in O(1) when one is available. A thread holds one registration at
+ * a time; registering with another domain releases the previous slot.
  *
  * @param domain  Domain to register with
  * @return LL_OK on success, LL_ERR_NOMEM if allocation fails
@@ -95,12 +494,28 @@ int ll_thread_register(ll_domain_t *domain);
 
 /*
  * Unregister the current thread from a domain. Call when the thread
- * is done using lists in this domain.
+ * is done using lists in this domain. Threads that exit without calling
+ * this are unregistered automatically: their hazard pointers and snapshot
+ * are cleared, their slot is released, and their retired nodes are handed
+ * to the domain to be freed by the next ll_reclaim() in any thread.
  *
  * @param domain  Domain to unregister from
  */
 void ll_thread_unregister(ll_domain_t *domain);
 
+/*
+ * Name the calling thread's slot for diagnostics: ll_domain_top_blockers()
+ * reports it, and ll_trace_dump() labels the slot's track with it. Longer
+ * names are truncated to LL_THREAD_NAME_MAX - 1 bytes; an empty name
+ * clears it. The name is dropped when the thread unregisters.
+ *
+ * @param domain  Domain the calling thread is registered with
+ * @param name    Name to set
+ * @return LL_OK on success, LL_ERR_INVAL if an argument is NULL,
+ *         LL_ERR_NOTHREAD if the thread is not registered with domain
+ */
+int ll_thread_set_name(ll_domain_t *domain, const char *name);
+
 /* ============== List Lifecycle ============== */
 
 /*
@@ -108,19 +523,78 @@ void ll_thread_unregister(ll_domain_t *domain);
  *
  * @param list    List head to initialize
  * @param domain  Domain for hazard pointer management
- * @return LL_OK on success, LL_ERR_INVAL if arguments are NULL
+ * @return LL_OK on success, LL_ERR_INVAL if arguments are NULL,
+ *         LL_ERR_NOMEM if the domain tracks contention and the list's
+ *         counters cannot be allocated
  */
 int ll_init(ll_head_t *list, ll_domain_t *domain);
 
 /*
- * Destroy a list. Frees all remaining nodes. The list must be quiescent
- * (no concurrent operations).
+ * Initialize a list head with options.
+ *
+ * LL_LIST_COMBINING suits lists where many threads insert at and pop from
+ * the head at once. Those calls publish the operation and one thread
+ * applies the whole batch: pops are matched with concurrent inserts
+ * directly, and the remaining inserts land with a single head update.
+ * Other operations are unaffected.
+ *
+ * LL_LIST_ELIMINATION lets an ll_insert_head() whose head CAS fails hand
+ * its element straight to an ll_remove_first() that also failed, so
+ * neither touches the list. The pair behaves as an insert immediately
+ * followed by a pop, so LIFO order is preserved.
+ *
+ * Independently of flags, every list tracks how often its head CAS fails
+ * and, when inserts contend, inflates into several insert stripes; it
+ * deflates again once inserts cool down. Other operations fold the
+ * stripes back in first, so snapshots, ll_remove() and ll_count() behave
+ * the same. LL_LIST_STRIPED starts the list inflated. Lists with
+ * LL_LIST_COMBINING never inflate, and LL_LIST_STRIPED cannot be combined
+ * with it.
+ *
+ * LL_LIST_PERCPU suits insert-heavy lists that are read in batches.
+ * Inserts push onto a buffer owned by the current CPU and touch neither
+ * the head nor commit_id. Buffered elements get their transaction ids when
+ * the next read operation merges them, or when a buffer fills up. A
+ * thread's own inserts keep their order. Cannot be combined with
+ * LL_LIST_COMBINING.
+ *
+ * LL_LIST_WAITFREE makes ll_insert_head() wait-free, for producers that
+ * need bounded insert latency. An insert swaps itself into the head with
+ * one atomic exchange and then links the old head behind it. A reader that
+ * reaches the node before it is linked spins until it is. Cannot be
+ * combined with other flags.
+ *
+ * labels registers the list with its domain's Prometheus export (see
+ * ll_stats_format_prometheus()) under a comma-separated list of
+ * name="value" pairs. Names follow Prometheus rules; values may use the
+ * \\, \" and \n escapes. The string is copied.
+ *
+ * @param list    List head to initialize
+ * @param domain  Domain for hazard pointer management
+ * @param config  Options, or NULL for a plain list
+ * @return LL_OK on success, LL_ERR_INVAL if arguments are NULL, flags
+ *         are unknown or conflict, or labels are malformed, LL_ERR_NOMEM
+ *         on allocation failure
+ */
+int ll_init_ex(ll_head_t *list, ll_domain_t *domain, const ll_list_config_t *config);
+
+/*
+ * Destroy a list. Frees all remaining nodes and any state allocated by
+ * ll_init_ex(). The list must be quiescent (no concurrent operations).
  *
  * @param list     List to destroy
  * @param free_cb  Callback to free user elements (may be NULL)
  */
 void ll_destroy(ll_head_t *list, void (*free_cb)(void *));
 
+/*
+ * Get the number of insert stripes a list is currently using.
+ *
+ * @param list  List to query
+ * @return Stripe (or per-CPU buffer) count, or 0 if the list is not inflated
+ */
+unsigned ll_list_stripes(ll_head_t *list);
+
 /* ============== Insert Operations ============== */
 
 /*
@@ -143,13 +617,15 @@ int ll_insert_head(ll_head_t *list, void *elm);
  * @param list  List to remove from
  * @param elm   User element to remove
  * @return LL_OK on success, LL_ERR_NOTFOUND if element not in list,
- *         LL_ERR_NOTHREAD if thread not registered
+ *         LL_ERR_NOTHREAD if thread not registered,
+ *         LL_ERR_FULL in a single-slot hazard domain
  */
 int ll_remove(ll_head_t *list, void *elm);
 
 /*
  * Remove and return the first visible element from the list.
- * This physically unlinks and frees the internal node immediately.
+ * This physically unlinks the internal node; it is freed once no hazard
+ * pointer protects it. The element is never passed to a free_cb.
  *
  * @param list     List to remove from
  * @param out_elm  Output: the removed user element (if any)
@@ -159,6 +635,43 @@ int ll_remove(ll_head_t *list, void *elm);
  */
 int ll_remove_first(ll_head_t *list, void **out_elm);
 
+/*
+ * Like ll_remove_first(), but if the list is empty, sleep until an insert
+ * makes an element available or the timeout expires. Sleeping consumers
+ * park on a futex tied to the list. Inserts check for sleepers with a
+ * plain load, and only make a wake-up call when one is parked.
+ *
+ * @param list        List to remove from
+ * @param out_elm     Output: the removed user element
+ * @param timeout_ms  Milliseconds to wait; 0 polls like ll_remove_first(),
+ *                    negative waits indefinitely
+ * @return LL_OK on success, LL_ERR_TIMEDOUT if a positive timeout expired,
+ *         or any error from ll_remove_first() (LL_ERR_NOTFOUND on an empty
+ *         list with a zero timeout)
+ */
+int ll_remove_first_wait(ll_head_t *list, void **out_elm, int timeout_ms);
+
+/*
+ * Signal an eventfd when the list becomes non-empty, for consumers that
+ * multiplex lists with sockets in epoll/poll loops. The descriptor is
+ * edge-triggered: it is signaled once on attach, and after that by the
+ * first insert following an ll_remove_first() that found the list empty.
+ * A consumer should therefore read the eventfd and then call
+ * ll_remove_first() until it returns LL_ERR_NOTFOUND. Bursts of inserts
+ * between drains coalesce into a single write. Any descriptor accepting
+ * 8-byte writes (such as a pipe) also works.
+ *
+ * The caller keeps ownership of fd. Detach it (fd = -1) and quiesce
+ * inserters before closing it.
+ *
+ * @param list   List to watch
+ * @param fd     Descriptor to signal, or -1 to detach
+ * @param flags  Reserved, must be 0
+ * @return LL_OK on success, LL_ERR_INVAL on bad arguments,
+ *         LL_ERR_NOMEM if the list's extension state could not be allocated
+ */
+int ll_attach_eventfd(ll_head_t *list, int fd, unsigned flags);
+
 /* ============== Snapshot & Traversal ============== */
 
 /*
@@ -175,6 +688,10 @@ int ll_iterator_begin(ll_head_t *list, ll_iterator_t *iter);
 /*
  * Get the next visible element from the iterator.
  *
+ * The returned element stays hazard-protected until the next call, so it
+ * is safe to dereference even if another thread pops and frees its node.
+ * If that happens, the iteration may end early.
+ *
  * @param iter  Iterator from ll_iterator_begin()
  * @return Next visible element, or NULL if no more elements
  */
@@ -222,6 +739,39 @@ bool ll_contains(ll_head_t *list, const void *elm);
  */
 size_t ll_count(ll_head_t *list);
 
+/*
+ * Report how much garbage a list's chain carries: tombstones, the ratio
+ * of tombstones to nodes, and the longest run of nodes a reader skips
+ * over, judged at the current commit_id. Walks the chain once, like
+ * ll_count().
+ *
+ * @param list  List to inspect
+ * @param out   Receives the report
+ * @return LL_OK on success, LL_ERR_INVAL if an argument is NULL
+ */
+int ll_list_health(ll_head_t *list, ll_list_health_t *out);
+
+/*
+ * Report how a list's chain is laid out in memory, to judge whether scans
+ * suffer from scattered nodes. Covers the distribution of address strides
+ * from each node to the next, the pages the nodes occupy against the fewest
+ * that could hold them, the NUMA node of those pages (Linux, where
+ * move_pages() is permitted), the distance from each node to its element,
+ * and the runs of visible and invisible nodes at the current commit_id.
+ * Strides and distances are bucketed by powers of two.
+ *
+ * The walk takes no hazard pointers, so call it at a quiescent point: no
+ * other thread may remove from or reclaim the list meanwhile.
+ *
+ * @param list    List to analyze
+ * @param out     Stream to write the report to
+ * @param format  LL_ANALYZE_TEXT or LL_ANALYZE_JSON
+ * @return LL_OK on success, LL_ERR_INVAL if an argument is invalid or
+ *         writing to out failed, LL_ERR_NOMEM if the page table cannot be
+ *         allocated
+ */
+int ll_debug_analyze(ll_head_t *list, FILE *out, ll_analyze_format_t format);
+
 /* ============== Memory Reclamation ============== */
 
 /*
@@ -233,6 +783,57 @@ size_t ll_count(ll_head_t *list);
  */
 void ll_reclaim(ll_head_t *list, void (*free_cb)(void *));
 
+/* ============== Caller Hazard Pointers ============== */
+
+/*
+ * Composite structures built on these lists can protect their own pointers
+ * with the hazard slots beyond the two used by list operations. While a
+ * reserved slot holds a pointer to a list node or to a user element,
+ * ll_reclaim() will not free that node or pass that element to free_cb.
+ * Reservations belong to the calling thread and are dropped when it
+ * unregisters.
+ */
+
+/*
+ * Reserve count hazard slots for the calling thread.
+ *
+ * @param domain  Domain the thread is registered with
+ * @param count   Number of slots to reserve
+ * @return Index of the first reserved slot (>= 0) on success,
+ *         LL_ERR_FULL if the domain's hp_slots are exhausted,
+ *         LL_ERR_NOTHREAD if thread not registered with domain
+ */
+int ll_hazard_reserve(ll_domain_t *domain, unsigned count);
+
+/*
+ * Release the slots reserved from first onwards, clearing their pointers.
+ * Reservations are stack-like: this also releases anything reserved later.
+ *
+ * @param domain  Domain the thread is registered with
+ * @param first   Index returned by ll_hazard_reserve()
+ */
+void ll_hazard_unreserve(ll_domain_t *domain, int first);
+
+/*
+ * Publish p in a reserved hazard slot. Re-validate that p is still
+ * reachable after publishing before dereferencing it.
+ *
+ * @param domain  Domain the thread is registered with
+ * @param slot    Reserved slot index
+ * @param p       Pointer to protect (NULL clears the slot)
+ * @return LL_OK on success, LL_ERR_INVAL if slot is not reserved,
+ *         LL_ERR_NOTHREAD if thread not registered with domain
+ */
+int ll_hazard_set(ll_domain_t *domain, int slot, const void *p);
+
+/*
+ * Clear a reserved hazard slot.
+ *
+ * @param domain  Domain the thread is registered with
+ * @param slot    Reserved slot index
+ */
+void ll_hazard_clear(ll_domain_t *domain, int slot);
+
 /* ============== Legacy API (Deprecated) ============== */
 
 /*
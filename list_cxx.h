@@ -14,6 +14,7 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 
 #ifdef __cplusplus
 
@@ -25,6 +26,8 @@
 #define LL_ERR_NOTHREAD -3
 #define LL_ERR_INVAL   -4
 #define LL_ERR_FULL    -5
+#define LL_ERR_TIMEDOUT -6
+#define LL_ERR_NOTSUP  -7
 
 /* ============== C++ Type Definitions ============== */
 
@@ -56,11 +59,157 @@ typedef std::atomic<uintptr_t> ll_atomic_uintptr_t;
 struct ll_domain;
 typedef ll_domain ll_domain_t;
 
+/* Internal per-list state. */
+struct ll_list_ext;
+
 /* List head structure - matches C layout. */
 struct ll_head_t {
     ll_atomic_uintptr_t head;
     ll_commit_id_t commit_id;
     ll_domain_t *domain;
+    std::atomic<ll_list_ext *> ext;
+    std::atomic<uint32_t> contention;
+};
+
+/* List flags for ll_init_ex(). */
+#define LL_LIST_COMBINING   0x1u
+#define LL_LIST_ELIMINATION 0x2u
+#define LL_LIST_STRIPED     0x4u
+#define LL_LIST_PERCPU      0x8u
+#define LL_LIST_WAITFREE    0x10u
+
+/* List configuration - matches C layout. */
+struct ll_list_config_t {
+    unsigned flags;
+    const char *labels;
+};
+
+/* Backoff policy - matches C enum. */
+enum ll_backoff_t {
+    LL_BACKOFF_AUTO = 0,
+    LL_BACKOFF_NONE,
+    LL_BACKOFF_EXPONENTIAL,
+    LL_BACKOFF_RANDOM
+};
+
+/* Publication fence mode - matches C enum. */
+enum ll_fence_t {
+    LL_FENCE_AUTO = 0,
+    LL_FENCE_SYMMETRIC
+};
+
+/* Read-side protection mode - matches C enum. */
+enum ll_read_mode_t {
+    LL_READ_HAZARD = 0,
+    LL_READ_QSBR
+};
+
+/* Domain configuration - matches C layout. */
+struct ll_domain_config_t {
+    size_t initial_threads;
+    unsigned hp_slots;
+    ll_backoff_t backoff;
+    ll_fence_t fences;
+    ll_read_mode_t read_mode;
+    size_t trace_events;
+    bool track_blockers;
+    bool track_contention;
+};
+
+/* Domain operation counters - matches C layout. */
+struct ll_stats_t {
+    uint64_t inserts;
+    uint64_t removes;
+    uint64_t remove_firsts;
+    uint64_t lookups;
+    uint64_t iterations;
+    uint64_t reclaims;
+    uint64_t insert_retries;
+    uint64_t remove_first_retries;
+    uint64_t nodes_visited;
+    uint64_t nodes_skipped;
+    uint64_t reclaim_passes;
+    uint64_t nodes_freed;
+    uint64_t nodes_held;
+};
+
+/* Timed operations - matches C enum. */
+enum ll_op_t {
+    LL_OP_INSERT = 0,
+    LL_OP_REMOVE,
+    LL_OP_REMOVE_FIRST,
+    LL_OP_ITERATE,
+    LL_OP_RECLAIM,
+    LL_OP_COUNT
+};
+
+#define LL_HIST_BUCKETS 256
+
+/* Latency histogram - matches C layout. */
+struct ll_histogram_t {
+    uint64_t count;
+    uint64_t sum_ns;
+    uint64_t max_ns;
+    uint64_t buckets[LL_HIST_BUCKETS];
+};
+
+/* List chain report - matches C layout. */
+struct ll_list_health_t {
+    uint64_t commit_id;
+    size_t nodes;
+    size_t tombstones;
+    size_t invisible;
+    size_t longest_invisible_run;
+    size_t markers;
+    double tombstone_ratio;
+};
+
+/* Thread slot reclamation state - matches C layout. */
+struct ll_thread_health_t {
+    bool in_use;
+    uint64_t active_snapshot;
+    size_t retired;
+    size_t hazard_held;
+};
+
+/* Domain reclamation state - matches C layout. */
+struct ll_domain_health_t {
+    size_t threads;
+    size_t slots;
+    size_t retired;
+    size_t orphans;
+    size_t retired_max;
+    size_t retired_max_slot;
+    size_t hazard_held;
+    uint64_t oldest_snapshot;
+    size_t oldest_snapshot_slot;
+};
+
+/* List heat counters - matches C layout. */
+struct ll_list_heat_t {
+    ll_head_t *list;
+    const char *labels;
+    uint64_t cas_failures;
+    uint64_t commits;
+    uint32_t readers;
+    uint32_t readers_max;
+};
+
+#define LL_THREAD_NAME_MAX 32
+
+/* Reclaim blocker entry - matches C layout. */
+struct ll_blocker_t {
+    size_t slot;
+    char name[LL_THREAD_NAME_MAX];
+    uint64_t active_snapshot;
+    uint64_t snapshot_holds;
+    uint64_t hazard_holds;
+};
+
+/* Layout report formats - matches C enum. */
+enum ll_analyze_format_t {
+    LL_ANALYZE_TEXT = 0,
+    LL_ANALYZE_JSON
 };
 
 /* Iterator structure - matches C layout. */
@@ -87,13 +236,34 @@ ll_domain_t *ll_domain_create(size_t initial_threads);
 void ll_domain_destroy(ll_domain_t *domain);
 int ll_thread_register(ll_domain_t *domain);
 void ll_thread_unregister(ll_domain_t *domain);
+int ll_thread_set_name(ll_domain_t *domain, const char *name);
+ll_domain_t *ll_domain_create_ex(const ll_domain_config_t *config);
+unsigned ll_domain_hp_slots(const ll_domain_t *domain);
+bool ll_domain_asymmetric_fences(const ll_domain_t *domain);
+void ll_domain_quiescent(ll_domain_t *domain);
+int ll_domain_stats(const ll_domain_t *domain, ll_stats_t *out);
+int ll_domain_health(const ll_domain_t *domain, ll_domain_health_t *out,
+                     ll_thread_health_t *threads, size_t max_threads);
+int ll_domain_top_blockers(const ll_domain_t *domain, ll_blocker_t *out, size_t k);
+int ll_domain_blockers_reset(ll_domain_t *domain);
+int ll_domain_top_contended(const ll_domain_t *domain, ll_list_heat_t *out, size_t k);
+int ll_domain_histograms(const ll_domain_t *domain, ll_histogram_t out[LL_OP_COUNT]);
+int ll_domain_histograms_reset(ll_domain_t *domain);
+int ll_trace_dump(const ll_domain_t *domain, FILE *out);
+int ll_stats_format_prometheus(const ll_domain_t *domain, char *buf, size_t len);
+void ll_histogram_merge(ll_histogram_t *dst, const ll_histogram_t *src);
+uint64_t ll_histogram_percentile(const ll_histogram_t *h, double pct);
 
 /* New API. */
 int ll_init(ll_head_t *list, ll_domain_t *domain);
+int ll_init_ex(ll_head_t *list, ll_domain_t *domain, const ll_list_config_t *config);
+unsigned ll_list_stripes(ll_head_t *list);
 void ll_destroy(ll_head_t *list, void (*free_cb)(void *));
 int ll_insert_head(ll_head_t *list, void *elm);
 int ll_remove(ll_head_t *list, void *elm);
 int ll_remove_first(ll_head_t *list, void **out_elm);
+int ll_remove_first_wait(ll_head_t *list, void **out_elm, int timeout_ms);
+int ll_attach_eventfd(ll_head_t *list, int fd, unsigned flags);
 int ll_iterator_begin(ll_head_t *list, ll_iterator_t *iter);
 void *ll_iterator_next(ll_iterator_t *iter);
 void ll_iterator_end(ll_iterator_t *iter);
@@ -101,8 +271,16 @@ uint64_t ll_iterator_snapshot(const ll_iterator_t *iter);
 bool ll_is_empty(ll_head_t *list);
 bool ll_contains(ll_head_t *list, const void *elm);
 size_t ll_count(ll_head_t *list);
+int ll_list_health(ll_head_t *list, ll_list_health_t *out);
+int ll_debug_analyze(ll_head_t *list, FILE *out, ll_analyze_format_t format);
 void ll_reclaim(ll_head_t *list, void (*free_cb)(void *));
 
+/* Caller hazard pointers. */
+int ll_hazard_reserve(ll_domain_t *domain, unsigned count);
+void ll_hazard_unreserve(ll_domain_t *domain, int first);
+int ll_hazard_set(ll_domain_t *domain, int slot, const void *p);
+void ll_hazard_clear(ll_domain_t *domain, int slot);
+
 /* Legacy API (deprecated but still supported). */
 void ll_init_(void *head, void *commit_id);
 void ll_insert_head_(void *head, void *commit_id, void *elm);
@@ -0,0 +1,24 @@
+# Fails unless LIBRARY carries a USDT note for every concurrent_ll probe.
+#
+#   cmake -DREADELF=<readelf> -DLIBRARY=<library> -P check_probes.cmake
+
+set(probes
+    insert remove remove_first cas_retry
+    snapshot_begin snapshot_end reclaim_start reclaim_done
+    node_retire node_free
+)
+
+execute_process(
+    COMMAND ${READELF} -n ${LIBRARY}
+    OUTPUT_VARIABLE notes
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${READELF} -n ${LIBRARY} failed")
+endif()
+
+foreach(probe IN LISTS probes)
+    if(NOT notes MATCHES "Provider: concurrent_ll[\r\n\t ]+Name: ${probe}[\r\n]")
+        message(FATAL_ERROR "probe concurrent_ll:${probe} missing from ${LIBRARY}")
+    endif()
+endforeach()
@@ -17,11 +17,18 @@
 #include <atomic>
 #include <chrono>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
 #include <catch2/catch.hpp>
 
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
 /* Use C++ compatibility header instead of C header. */
 #include "list_cxx.h"
 
@@ -580,123 +587,2035 @@ TEST_CASE("New API: Utility functions", "[concurrent_ll][new_api][utility]")
         REQUIRE(ll_contains(&list, nullptr) == false);
     }
 
-    SECTION("ll_count on empty list")
-    {
-        REQUIRE(ll_count(&list) == 0);
-    }
+    SECTION("ll_count on empty list")
+    {
+        REQUIRE(ll_count(&list) == 0);
+    }
+
+    SECTION("ll_count on list with elements")
+    {
+        for (int i = 0; i < 5; i++) {
+            ll_insert_head(&list, create_item(i, i * 10));
+        }
+        REQUIRE(ll_count(&list) == 5);
+        ll_destroy(&list, test_item_free_void);
+    }
+
+    SECTION("ll_count with null list")
+    {
+        REQUIRE(ll_count(nullptr) == 0);
+    }
+
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+/* ==================== New API: List Destroy Tests ==================== */
+
+TEST_CASE("New API: List destroy", "[concurrent_ll][new_api][destroy]")
+{
+    ll_domain_t *domain = ll_domain_create(4);
+    REQUIRE(domain != nullptr);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+
+    SECTION("Destroy empty list")
+    {
+        ll_head_t list;
+        REQUIRE(ll_init(&list, domain) == LL_OK);
+        ll_destroy(&list, nullptr);  /* No callback needed for empty list. */
+    }
+
+    SECTION("Destroy list with elements and callback")
+    {
+        ll_head_t list;
+        REQUIRE(ll_init(&list, domain) == LL_OK);
+
+        freed_count.store(0);
+        for (int i = 0; i < 5; i++) {
+            ll_insert_head(&list, create_item(i, i * 10));
+        }
+
+        ll_destroy(&list, test_item_free_void);
+        REQUIRE(freed_count.load() == 5);
+    }
+
+    SECTION("Destroy list with elements without callback")
+    {
+        ll_head_t list;
+        REQUIRE(ll_init(&list, domain) == LL_OK);
+
+        /* These items will leak if no callback, but test ensures no crash. */
+        for (int i = 0; i < 3; i++) {
+            ll_insert_head(&list, create_item(i, i * 10));
+        }
+
+        ll_destroy(&list, nullptr);
+        /* No crash = success. Items leaked intentionally for this test. */
+    }
+
+    SECTION("Destroy null list is safe")
+    {
+        ll_destroy(nullptr, test_item_free_void);  /* Should not crash. */
+    }
+
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+/* ==================== New API: Reclaim Tests ==================== */
+
+TEST_CASE("New API: Memory reclamation", "[concurrent_ll][new_api][reclaim]")
+{
+    ll_domain_t *domain = ll_domain_create(4);
+    REQUIRE(domain != nullptr);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+
+    SECTION("Reclaim frees removed nodes")
+    {
+        freed_count.store(0);
+        test_item *item = create_item(1, 100);
+        ll_insert_head(&list, item);
+        ll_remove(&list, item);
+
+        ll_reclaim(&list, test_item_free_void);
+
+        /* Node should be freed. */
+        REQUIRE(freed_count.load() >= 1);
+    }
+
+    SECTION("Reclaim with no removed nodes is safe")
+    {
+        test_item *item = create_item(1, 100);
+        ll_insert_head(&list, item);
+
+        ll_reclaim(&list, nullptr);  /* No crash, nothing to reclaim. */
+
+        ll_destroy(&list, test_item_free_void);
+    }
+
+    SECTION("Reclaim with null list is safe")
+    {
+        ll_reclaim(nullptr, test_item_free_void);  /* Should not crash. */
+    }
+
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+/* ==================== New API: Hazard Slot Tests ==================== */
+
+TEST_CASE("New API: Configurable hazard slots", "[concurrent_ll][new_api][hazard]")
+{
+    SECTION("Default domain has two slots")
+    {
+        ll_domain_t *domain = ll_domain_create(0);
+        REQUIRE(ll_domain_hp_slots(domain) == 2);
+        ll_domain_destroy(domain);
+    }
+
+    SECTION("Too many slots is rejected")
+    {
+        ll_domain_config_t config = {};
+        config.hp_slots = 65;
+        REQUIRE(ll_domain_create_ex(&config) == nullptr);
+        REQUIRE(ll_domain_create_ex(nullptr) == nullptr);
+    }
+
+    SECTION("Single-slot domain supports read paths")
+    {
+        ll_domain_config_t config = {};
+        config.hp_slots = 1;
+        ll_domain_t *domain = ll_domain_create_ex(&config);
+        REQUIRE(domain != nullptr);
+        REQUIRE(ll_domain_hp_slots(domain) == 1);
+        REQUIRE(ll_thread_register(domain) == LL_OK);
+
+        ll_head_t list;
+        REQUIRE(ll_init(&list, domain) == LL_OK);
+        test_item *a = create_item(1, 10);
+        test_item *b = create_item(2, 20);
+        REQUIRE(ll_insert_head(&list, a) == LL_OK);
+        REQUIRE(ll_insert_head(&list, b) == LL_OK);
+
+        ll_iterator_t iter;
+        REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+        REQUIRE(ll_iterator_next(&iter) == b);
+        REQUIRE(ll_iterator_next(&iter) == a);
+        REQUIRE(ll_iterator_next(&iter) == nullptr);
+        ll_iterator_end(&iter);
+
+        REQUIRE(ll_remove(&list, a) == LL_ERR_FULL);
+        REQUIRE(ll_count(&list) == 2);
+
+        void *out = nullptr;
+        REQUIRE(ll_remove_first(&list, &out) == LL_ERR_FULL);
+        REQUIRE(ll_hazard_reserve(domain, 1) == LL_ERR_FULL);
+
+        ll_destroy(&list, test_item_free_void);
+        ll_thread_unregister(domain);
+        ll_domain_destroy(domain);
+
+        /* QSBR walks without hazards, so removes need no second slot. */
+        config.read_mode = LL_READ_QSBR;
+        domain = ll_domain_create_ex(&config);
+        REQUIRE(domain != nullptr);
+        REQUIRE(ll_thread_register(domain) == LL_OK);
+        REQUIRE(ll_init(&list, domain) == LL_OK);
+        a = create_item(1, 10);
+        REQUIRE(ll_insert_head(&list, a) == LL_OK);
+        REQUIRE(ll_remove(&list, a) == LL_OK);
+        REQUIRE(ll_count(&list) == 0);
+
+        ll_destroy(&list, test_item_free_void);
+        ll_thread_unregister(domain);
+        ll_domain_destroy(domain);
+    }
+}
+
+TEST_CASE("New API: Reserved hazard slots hold back reclamation", "[concurrent_ll][new_api][hazard][reclaim]")
+{
+    ll_domain_config_t config = {};
+    config.hp_slots = 4;
+    ll_domain_t *domain = ll_domain_create_ex(&config);
+    REQUIRE(domain != nullptr);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+
+    SECTION("Reservations are stack-like")
+    {
+        int first = ll_hazard_reserve(domain, 1);
+        REQUIRE(first == 2);
+        REQUIRE(ll_hazard_reserve(domain, 1) == 3);
+        REQUIRE(ll_hazard_reserve(domain, 1) == LL_ERR_FULL);
+
+        ll_hazard_unreserve(domain, first);
+        REQUIRE(ll_hazard_set(domain, first, nullptr) == LL_ERR_INVAL);
+        REQUIRE(ll_hazard_set(domain, 0, nullptr) == LL_ERR_INVAL);
+        REQUIRE(ll_hazard_reserve(domain, 2) == 2);
+        ll_hazard_unreserve(domain, 2);
+    }
+
+    SECTION("Protected element is not freed until cleared")
+    {
+        int slot = ll_hazard_reserve(domain, 1);
+        REQUIRE(slot >= 0);
+
+        test_item *item = create_item(1, 100);
+        REQUIRE(ll_insert_head(&list, item) == LL_OK);
+        REQUIRE(ll_hazard_set(domain, slot, item) == LL_OK);
+        REQUIRE(ll_remove(&list, item) == LL_OK);
+
+        freed_count.store(0);
+        ll_reclaim(&list, test_item_free_void);
+        REQUIRE(freed_count.load() == 0);
+        REQUIRE(item->id == 1);  /* Still safe to read. */
+
+        ll_hazard_clear(domain, slot);
+        ll_reclaim(&list, test_item_free_void);
+        REQUIRE(freed_count.load() == 1);
+
+        ll_hazard_unreserve(domain, slot);
+    }
+
+    SECTION("Held nodes are handed off when the reclaiming thread exits")
+    {
+        int slot = ll_hazard_reserve(domain, 1);
+        REQUIRE(slot >= 0);
+
+        test_item *item = create_item(2, 200);
+        REQUIRE(ll_insert_head(&list, item) == LL_OK);
+        REQUIRE(ll_hazard_set(domain, slot, item) == LL_OK);
+        REQUIRE(ll_remove(&list, item) == LL_OK);
+
+        freed_count.store(0);
+        std::thread reclaimer([&]() {
+            REQUIRE(ll_thread_register(domain) == LL_OK);
+            ll_reclaim(&list, test_item_free_void);
+            /* Exit without unregistering, still holding the retired node. */
+        });
+        reclaimer.join();
+        REQUIRE(freed_count.load() == 0);
+
+        ll_hazard_clear(domain, slot);
+        ll_reclaim(&list, test_item_free_void);
+        REQUIRE(freed_count.load() == 1);
+
+        ll_hazard_unreserve(domain, slot);
+    }
+
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+/* ==================== New API: Backoff Tests ==================== */
+
+TEST_CASE("New API: Backoff policies", "[concurrent_ll][new_api][backoff][concurrent]")
+{
+    ll_domain_config_t config = {};
+    config.backoff = static_cast<ll_backoff_t>(LL_BACKOFF_RANDOM + 1);
+    REQUIRE(ll_domain_create_ex(&config) == nullptr);
+
+    const ll_backoff_t policies[] = {LL_BACKOFF_AUTO, LL_BACKOFF_NONE,
+                                     LL_BACKOFF_EXPONENTIAL, LL_BACKOFF_RANDOM};
+    for (ll_backoff_t policy : policies) {
+        config.backoff = policy;
+        ll_domain_t *domain = ll_domain_create_ex(&config);
+        REQUIRE(domain != nullptr);
+
+        REQUIRE(ll_thread_register(domain) == LL_OK);
+        ll_head_t list;
+        REQUIRE(ll_init(&list, domain) == LL_OK);
+
+        /* Every thread pushes its items and pops from the shared head. */
+        const int num_threads = 8;
+        const int items_per_thread = 200;
+        const int total = num_threads * items_per_thread;
+        std::vector<std::atomic<int>> popped(total);
+        std::vector<test_item *> items(total);
+        for (int i = 0; i < total; i++)
+            items[i] = create_item(i, i);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&, t]() {
+                ll_thread_register(domain);
+                for (int i = 0; i < items_per_thread; i++) {
+                    ll_insert_head(&list, items[t * items_per_thread + i]);
+                    void *out = nullptr;
+                    if (ll_remove_first(&list, &out) == LL_OK)
+                        popped[static_cast<test_item *>(out)->id].fetch_add(1);
+                }
+                ll_thread_unregister(domain);
+            });
+        }
+        for (auto &t : threads)
+            t.join();
+
+        void *out = nullptr;
+        while (ll_remove_first(&list, &out) == LL_OK)
+            popped[static_cast<test_item *>(out)->id].fetch_add(1);
+
+        for (int i = 0; i < total; i++)
+            REQUIRE(popped[i].load() == 1);
+
+        for (test_item *item : items)
+            delete item;
+        ll_destroy(&list, nullptr);
+        ll_thread_unregister(domain);
+        ll_domain_destroy(domain);
+    }
+}
+
+/* ==================== New API: Flat Combining Tests ==================== */
+
+TEST_CASE("New API: Publication fences", "[concurrent_ll][new_api][fences]")
+{
+    ll_domain_config_t bad = {};
+    bad.fences = static_cast<ll_fence_t>(7);
+    REQUIRE(ll_domain_create_ex(&bad) == nullptr);
+    REQUIRE_FALSE(ll_domain_asymmetric_fences(nullptr));
+
+    for (ll_fence_t mode : {LL_FENCE_AUTO, LL_FENCE_SYMMETRIC}) {
+        ll_domain_config_t config = {};
+        config.fences = mode;
+        ll_domain_t *domain = ll_domain_create_ex(&config);
+        REQUIRE(domain != nullptr);
+        if (mode == LL_FENCE_SYMMETRIC)
+            REQUIRE_FALSE(ll_domain_asymmetric_fences(domain));
+
+        REQUIRE(ll_thread_register(domain) == LL_OK);
+        ll_head_t list;
+        REQUIRE(ll_init(&list, domain) == LL_OK);
+        for (int i = 0; i < 200; i++)
+            REQUIRE(ll_insert_head(&list, create_item(i, i)) == LL_OK);
+
+        /* Readers dereference every element while a writer removes and frees. */
+        std::atomic<bool> done{false};
+        std::atomic<int> bad_reads{0};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; r++) {
+            readers.emplace_back([&]() {
+                ll_thread_register(domain);
+                while (!done.load()) {
+                    ll_iterator_t iter;
+                    ll_iterator_begin(&list, &iter);
+                    void *elm;
+                    while ((elm = ll_iterator_next(&iter)) != nullptr) {
+                        test_item *item = static_cast<test_item *>(elm);
+                        if (item->id != item->value)
+                            bad_reads.fetch_add(1);
+                    }
+                    ll_iterator_end(&iter);
+                }
+                ll_thread_unregister(domain);
+            });
+        }
+
+        /* Popped elements go straight to the caller, so readers may still hold them. */
+        std::vector<test_item *> popped;
+        for (int round = 0; round < 200; round++) {
+            void *out = nullptr;
+            if (ll_remove_first(&list, &out) == LL_OK)
+                popped.push_back(static_cast<test_item *>(out));
+            ll_insert_head(&list, create_item(1000 + round, 1000 + round));
+            ll_iterator_t iter;
+            ll_iterator_begin(&list, &iter);
+            test_item *victim = static_cast<test_item *>(ll_iterator_next(&iter));
+            ll_iterator_end(&iter);
+            if (victim)
+                ll_remove(&list, victim);
+            ll_reclaim(&list, test_item_free_void);
+        }
+        done.store(true);
+        for (auto &t : readers)
+            t.join();
+        for (test_item *item : popped)
+            delete item;
+        /* Readers may have unlinked nodes the writer marked; free their elements too. */
+        ll_reclaim(&list, test_item_free_void);
+
+        REQUIRE(bad_reads.load() == 0);
+        ll_destroy(&list, test_item_free_void);
+        ll_thread_unregister(domain);
+        ll_domain_destroy(domain);
+    }
+}
+
+TEST_CASE("New API: QSBR read mode", "[concurrent_ll][new_api][qsbr]")
+{
+    ll_domain_config_t bad = {};
+    bad.read_mode = static_cast<ll_read_mode_t>(7);
+    REQUIRE(ll_domain_create_ex(&bad) == nullptr);
+
+    ll_domain_config_t config = {};
+    config.read_mode = LL_READ_QSBR;
+    ll_domain_t *domain = ll_domain_create_ex(&config);
+    REQUIRE(domain != nullptr);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+
+    SECTION("Registered threads hold back frees until quiescent")
+    {
+        test_item *a = create_item(1, 10);
+        test_item *b = create_item(2, 20);
+        REQUIRE(ll_insert_head(&list, a) == LL_OK);
+        REQUIRE(ll_insert_head(&list, b) == LL_OK);
+        REQUIRE(ll_count(&list) == 2);
+        REQUIRE(ll_contains(&list, a));
+
+        /* Alone in the domain, a grace period ends immediately. */
+        freed_count.store(0);
+        REQUIRE(ll_remove(&list, a) == LL_OK);
+        ll_reclaim(&list, test_item_free_void);
+        REQUIRE(freed_count.load() == 1);
+
+        std::atomic<int> phase{0};
+        std::thread idle([&]() {
+            ll_thread_register(domain);
+            phase.store(1);
+            while (phase.load() != 2)
+                std::this_thread::yield();
+            ll_domain_quiescent(domain);
+            phase.store(3);
+            while (phase.load() != 4)
+                std::this_thread::yield();
+            ll_thread_unregister(domain);
+        });
+        while (phase.load() != 1)
+            std::this_thread::yield();
+
+        REQUIRE(ll_remove(&list, b) == LL_OK);
+        ll_reclaim(&list, test_item_free_void);
+        REQUIRE(freed_count.load() == 1);
+        ll_reclaim(&list, test_item_free_void);
+        REQUIRE(freed_count.load() == 1);
+
+        phase.store(2);
+        while (phase.load() != 3)
+            std::this_thread::yield();
+        ll_reclaim(&list, test_item_free_void);
+        REQUIRE(freed_count.load() == 2);
+
+        phase.store(4);
+        idle.join();
+        REQUIRE(ll_is_empty(&list));
+    }
+
+    SECTION("Readers run without hazards against a writer")
+    {
+        for (int i = 0; i < 200; i++)
+            REQUIRE(ll_insert_head(&list, create_item(i, i)) == LL_OK);
+
+        std::atomic<bool> done{false};
+        std::atomic<int> bad_reads{0};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; r++) {
+            readers.emplace_back([&]() {
+                ll_thread_register(domain);
+                while (!done.load()) {
+                    ll_iterator_t iter;
+                    ll_iterator_begin(&list, &iter);
+                    void *elm;
+                    while ((elm = ll_iterator_next(&iter)) != nullptr) {
+                        test_item *item = static_cast<test_item *>(elm);
+                        if (item->id != item->value)
+                            bad_reads.fetch_add(1);
+                    }
+                    ll_iterator_end(&iter);
+                    if (ll_count(&list) > 400)
+                        bad_reads.fetch_add(1);
+                }
+                ll_thread_unregister(domain);
+            });
+        }
+
+        std::vector<test_item *> popped;
+        for (int round = 0; round < 200; round++) {
+            void *out = nullptr;
+            if (ll_remove_first(&list, &out) == LL_OK)
+                popped.push_back(static_cast<test_item *>(out));
+            ll_insert_head(&list, create_item(1000 + round, 1000 + round));
+            ll_iterator_t iter;
+            ll_iterator_begin(&list, &iter);
+            test_item *victim = static_cast<test_item *>(ll_iterator_next(&iter));
+            ll_iterator_end(&iter);
+            if (victim)
+                ll_remove(&list, victim);
+            ll_reclaim(&list, test_item_free_void);
+        }
+        done.store(true);
+        for (auto &t : readers)
+            t.join();
+        for (test_item *item : popped)
+            delete item;
+        ll_reclaim(&list, test_item_free_void);
+        REQUIRE(bad_reads.load() == 0);
+    }
+
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+TEST_CASE("New API: Cooperative reclaim", "[concurrent_ll][new_api][reclaim]")
+{
+    ll_domain_t *domain = ll_domain_create(0);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+
+    /* Tombstones made under an open snapshot survive the first pass, which splits the chain. */
+    const int total = 40000;
+    ll_iterator_t iter;
+    REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+    for (int i = 0; i < total; i++) {
+        test_item *item = create_item(i, i);
+        REQUIRE(ll_insert_head(&list, item) == LL_OK);
+        if (i % 2)
+            REQUIRE(ll_remove(&list, item) == LL_OK);
+    }
+    freed_count.store(0);
+    ll_reclaim(&list, test_item_free_void);
+    REQUIRE(freed_count.load() == 0);
+    ll_iterator_end(&iter);
+
+    std::vector<std::thread> reclaimers;
+    for (int t = 0; t < 4; t++) {
+        reclaimers.emplace_back([&]() {
+            ll_thread_register(domain);
+            ll_reclaim(&list, test_item_free_void);
+            ll_thread_unregister(domain);
+        });
+    }
+    for (auto &t : reclaimers)
+        t.join();
+    ll_reclaim(&list, test_item_free_void);
+    REQUIRE(freed_count.load() == total / 2);
+
+    /* Markers are invisible to every read path. */
+    REQUIRE(ll_count(&list) == static_cast<size_t>(total / 2));
+    size_t seen = 0;
+    bool ordered = true;
+    int expect = total - 2;
+    REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+    void *elm;
+    while ((elm = ll_iterator_next(&iter)) != nullptr) {
+        ordered = ordered && static_cast<test_item *>(elm)->id == expect;
+        expect -= 2;
+        seen++;
+    }
+    ll_iterator_end(&iter);
+    REQUIRE(ordered);
+    REQUIRE(seen == static_cast<size_t>(total / 2));
+
+    /* Draining the list merges the emptied segments away again. */
+    void *out = nullptr;
+    while (ll_remove_first(&list, &out) == LL_OK)
+        delete static_cast<test_item *>(out);
+    for (int i = 0; i < 3; i++)
+        ll_reclaim(&list, test_item_free_void);
+    REQUIRE(ll_is_empty(&list));
+    REQUIRE(ll_insert_head(&list, create_item(1, 1)) == LL_OK);
+    REQUIRE(ll_remove_first(&list, &out) == LL_OK);
+    delete static_cast<test_item *>(out);
+
+    /* Reclaimers sharing segments while poppers unlink from the front. */
+    for (int i = 0; i < total; i++) {
+        test_item *item = create_item(i, i);
+        REQUIRE(ll_insert_head(&list, item) == LL_OK);
+        if (i % 2)
+            REQUIRE(ll_remove(&list, item) == LL_OK);
+    }
+    ll_reclaim(&list, test_item_free_void);  /* Splits the chain again */
+    for (int i = 0; i < total; i++) {
+        test_item *item = create_item(total + i, total + i);
+        REQUIRE(ll_insert_head(&list, item) == LL_OK);
+        if (i % 2)
+            REQUIRE(ll_remove(&list, item) == LL_OK);
+    }
+    freed_count.store(0);
+    std::atomic<int> popped{0};
+    std::atomic<int> poppers_left{2};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; t++) {
+        workers.emplace_back([&, t]() {
+            ll_thread_register(domain);
+            if (t < 2) {
+                void *elm_out = nullptr;
+                while (ll_remove_first(&list, &elm_out) == LL_OK) {
+                    delete static_cast<test_item *>(elm_out);
+                    popped.fetch_add(1);
+                }
+                poppers_left.fetch_sub(1);
+            } else {
+                while (poppers_left.load() > 0)
+                    ll_reclaim(&list, test_item_free_void);
+            }
+            ll_thread_unregister(domain);
+        });
+    }
+    for (auto &t : workers)
+        t.join();
+    ll_reclaim(&list, test_item_free_void);
+    REQUIRE(popped.load() == total);
+    REQUIRE(freed_count.load() == total / 2);
+    REQUIRE(ll_is_empty(&list));
+
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+TEST_CASE("New API: Generational reclaim", "[concurrent_ll][new_api][reclaim]")
+{
+    ll_domain_t *domain = ll_domain_create(0);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+
+    /* Three generations of 4096: the first reclaim places their markers, the next sweeps them all. */
+    const int total = 3 * 4096 + 100;
+    std::vector<test_item *> items;
+    for (int i = 0; i < total; i++) {
+        items.push_back(create_item(i, i));
+        REQUIRE(ll_insert_head(&list, items.back()) == LL_OK);
+    }
+    ll_reclaim(&list, test_item_free_void);
+    ll_reclaim(&list, test_item_free_void);
+
+    /* Tombstones are charged to their own generation, old or new. */
+    freed_count.store(0);
+    REQUIRE(ll_remove(&list, items[3]) == LL_OK);
+    REQUIRE(ll_remove(&list, items[total / 2]) == LL_OK);
+    REQUIRE(ll_remove(&list, items[total - 3]) == LL_OK);
+    ll_reclaim(&list, test_item_free_void);
+    REQUIRE(freed_count.load() == 3);
+
+    /* One kept for a snapshot stays counted until it can go. */
+    ll_iterator_t iter;
+    REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+    REQUIRE(ll_remove(&list, items[4096 + 7]) == LL_OK);
+    ll_reclaim(&list, test_item_free_void);
+    REQUIRE(freed_count.load() == 3);
+    ll_iterator_end(&iter);
+    ll_reclaim(&list, test_item_free_void);
+    REQUIRE(freed_count.load() == 4);
+
+    /* Nothing removed: no pass frees or loses anything. */
+    for (int i = 0; i < 20; i++)
+        ll_reclaim(&list, test_item_free_void);
+    REQUIRE(freed_count.load() == 4);
+    REQUIRE(ll_count(&list) == static_cast<size_t>(total - 4));
+
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+TEST_CASE("New API: Single-slot domains reclaim concurrently", "[concurrent_ll][new_api][concurrent][reclaim]")
+{
+    ll_domain_config_t config = {};
+    config.hp_slots = 1;
+    ll_domain_t *domain = ll_domain_create_ex(&config);
+    REQUIRE(domain != nullptr);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+
+    /* Reclaimers take turns placing markers while inserts keep coming. */
+    const int per_thread = 3 * 4096;
+    std::atomic<int> inserting{2};
+    freed_count.store(0);
+
+    auto inserter = [&](int base) {
+        ll_thread_register(domain);
+        for (int i = 0; i < per_thread; i++)
+            ll_insert_head(&list, create_item(base + i, i));
+        inserting.fetch_sub(1);
+        ll_thread_unregister(domain);
+    };
+    auto reclaimer = [&]() {
+        ll_thread_register(domain);
+        while (inserting.load() > 0)
+            ll_reclaim(&list, test_item_free_void);
+        ll_thread_unregister(domain);
+    };
+    std::thread i1(inserter, 0), i2(inserter, per_thread);
+    std::thread r1(reclaimer), r2(reclaimer);
+    i1.join();
+    i2.join();
+    r1.join();
+    r2.join();
+
+    ll_reclaim(&list, test_item_free_void);
+    REQUIRE(freed_count.load() == 0);
+    REQUIRE(ll_count(&list) == static_cast<size_t>(2 * per_thread));
+
+    ll_destroy(&list, test_item_free_void);
+    REQUIRE(freed_count.load() == 2 * per_thread);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+TEST_CASE("New API: Domain stats", "[concurrent_ll][new_api][stats]")
+{
+    ll_domain_t *domain = ll_domain_create(0);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+    ll_stats_t stats;
+    REQUIRE(ll_domain_stats(nullptr, &stats) == LL_ERR_INVAL);
+    REQUIRE(ll_domain_stats(domain, nullptr) == LL_ERR_INVAL);
+
+#ifndef LL_STATS
+    REQUIRE(ll_domain_stats(domain, &stats) == LL_ERR_NOTSUP);
+    REQUIRE(stats.inserts == 0);
+#else
+    /* 10 inserts, 3 pops, 2 tombstones: 7 nodes, 5 visible. */
+    std::vector<test_item *> items;
+    for (int i = 0; i < 10; i++) {
+        items.push_back(create_item(i, i));
+        REQUIRE(ll_insert_head(&list, items.back()) == LL_OK);
+    }
+    void *out = nullptr;
+    for (int i = 0; i < 3; i++) {
+        REQUIRE(ll_remove_first(&list, &out) == LL_OK);
+        delete static_cast<test_item *>(out);
+    }
+    REQUIRE(ll_remove(&list, items[0]) == LL_OK);
+    REQUIRE(ll_remove(&list, items[4]) == LL_OK);
+
+    REQUIRE(ll_count(&list) == 5);
+    ll_iterator_t iter;
+    REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+    while (ll_iterator_next(&iter) != nullptr) {
+    }
+    ll_iterator_end(&iter);
+    ll_reclaim(&list, test_item_free_void);
+
+    /* A thread that has gone still counts. */
+    std::thread other([&]() {
+        ll_thread_register(domain);
+        for (int i = 0; i < 5; i++)
+            ll_insert_head(&list, create_item(100 + i, i));
+        ll_thread_unregister(domain);
+    });
+    other.join();
+
+    REQUIRE(ll_domain_stats(domain, &stats) == LL_OK);
+    REQUIRE(stats.inserts == 15);
+    REQUIRE(stats.removes == 2);
+    REQUIRE(stats.remove_firsts == 3);
+    REQUIRE(stats.lookups == 1);
+    REQUIRE(stats.iterations == 1);
+    REQUIRE(stats.reclaims == 1);
+    REQUIRE(stats.nodes_visited == 14);
+    REQUIRE(stats.nodes_skipped == 4);
+    REQUIRE(stats.reclaim_passes >= 1);
+    REQUIRE(stats.nodes_freed == 5);
+    REQUIRE(stats.nodes_held == 0);
+#endif
+
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+TEST_CASE("New API: Latency histograms", "[concurrent_ll][new_api][stats]")
+{
+    SECTION("Merge and percentiles") {
+        ll_histogram_t a{}, b{};
+        a.buckets[1] = 50;  /* 50 samples of 1 ns */
+        a.count = 50;
+        a.sum_ns = 50;
+        a.max_ns = 1;
+        b.buckets[7] = 49;
+        b.buckets[LL_HIST_BUCKETS - 1] = 1;
+        b.count = 50;
+        b.sum_ns = 49 * 7 + 1000000000000ull;
+        b.max_ns = 1000000000000ull;
+        ll_histogram_merge(&a, &b);
+        REQUIRE(a.count == 100);
+        REQUIRE(a.max_ns == b.max_ns);
+        REQUIRE(ll_histogram_percentile(&a, 50.0) == 1);
+        REQUIRE(ll_histogram_percentile(&a, 99.0) == 7);
+        REQUIRE(ll_histogram_percentile(&a, 99.9) == b.max_ns);
+        REQUIRE(ll_histogram_percentile(&a, 100.0) == b.max_ns);
+        ll_histogram_t empty{};
+        REQUIRE(ll_histogram_percentile(&empty, 50.0) == 0);
+    }
+
+    SECTION("Domain histograms") {
+        ll_domain_t *domain = ll_domain_create(0);
+        REQUIRE(ll_thread_register(domain) == LL_OK);
+        ll_head_t list;
+        REQUIRE(ll_init(&list, domain) == LL_OK);
+        std::vector<ll_histogram_t> hist(LL_OP_COUNT);
+        REQUIRE(ll_domain_histograms(nullptr, hist.data()) == LL_ERR_INVAL);
+
+#ifndef LL_HISTOGRAMS
+        REQUIRE(ll_domain_histograms(domain, hist.data()) == LL_ERR_NOTSUP);
+        REQUIRE(ll_domain_histograms_reset(domain) == LL_ERR_NOTSUP);
+#else
+        std::vector<test_item *> items;
+        for (int i = 0; i < 100; i++) {
+            items.push_back(create_item(i, i));
+            REQUIRE(ll_insert_head(&list, items.back()) == LL_OK);
+        }
+        for (int i = 0; i < 10; i++)
+            REQUIRE(ll_remove(&list, items[i]) == LL_OK);
+        ll_iterator_t iter;
+        REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+        while (ll_iterator_next(&iter) != nullptr) {
+        }
+        ll_iterator_end(&iter);
+        ll_reclaim(&list, test_item_free_void);
+
+        REQUIRE(ll_domain_histograms(domain, hist.data()) == LL_OK);
+        REQUIRE(hist[LL_OP_INSERT].count == 100);
+        REQUIRE(hist[LL_OP_REMOVE].count == 10);
+        REQUIRE(hist[LL_OP_REMOVE_FIRST].count == 0);
+        REQUIRE(hist[LL_OP_ITERATE].count == 1);
+        REQUIRE(hist[LL_OP_RECLAIM].count == 1);
+        uint64_t p50 = ll_histogram_percentile(&hist[LL_OP_INSERT], 50.0);
+        REQUIRE(p50 > 0);
+        REQUIRE(p50 <= hist[LL_OP_INSERT].max_ns);
+        REQUIRE(hist[LL_OP_INSERT].sum_ns >= hist[LL_OP_INSERT].max_ns);
+
+        REQUIRE(ll_domain_histograms_reset(domain) == LL_OK);
+        REQUIRE(ll_domain_histograms(domain, hist.data()) == LL_OK);
+        REQUIRE(hist[LL_OP_INSERT].count == 0);
+        REQUIRE(ll_insert_head(&list, create_item(100, 100)) == LL_OK);
+        REQUIRE(ll_domain_histograms(domain, hist.data()) == LL_OK);
+        REQUIRE(hist[LL_OP_INSERT].count == 1);
+        REQUIRE(hist[LL_OP_REMOVE].count == 0);
+#endif
+
+        ll_destroy(&list, test_item_free_void);
+        ll_thread_unregister(domain);
+        ll_domain_destroy(domain);
+    }
+}
+
+/* Read back and close a tmpfile() the library wrote to. */
+static std::string stream_string(FILE *f)
+{
+    std::string text;
+    rewind(f);
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        text.append(buf, n);
+    fclose(f);
+    return text;
+}
+
+static std::string trace_dump_string(ll_domain_t *domain)
+{
+    FILE *f = tmpfile();
+    REQUIRE(f != nullptr);
+    REQUIRE(ll_trace_dump(domain, f) == LL_OK);
+    return stream_string(f);
+}
+
+static size_t count_substr(const std::string &text, const std::string &needle)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1))
+        count++;
+    return count;
+}
+
+TEST_CASE("New API: Trace dump", "[concurrent_ll][new_api][trace]")
+{
+    ll_domain_config_t config = {};
+    config.trace_events = (1u << 24) + 1;
+    REQUIRE(ll_domain_create_ex(&config) == nullptr);
+    REQUIRE(ll_trace_dump(nullptr, stdout) == LL_ERR_INVAL);
+
+    SECTION("Untraced domain writes an empty trace") {
+        ll_domain_t *domain = ll_domain_create(0);
+        REQUIRE(ll_thread_register(domain) == LL_OK);
+        ll_head_t list;
+        REQUIRE(ll_init(&list, domain) == LL_OK);
+        REQUIRE(ll_insert_head(&list, create_item(1, 1)) == LL_OK);
+        std::string text = trace_dump_string(domain);
+        REQUIRE(text.rfind("{\"traceEvents\":[", 0) == 0);
+        REQUIRE(count_substr(text, "\"cat\"") == 0);
+        ll_destroy(&list, test_item_free_void);
+        ll_thread_unregister(domain);
+        ll_domain_destroy(domain);
+    }
+
+    SECTION("Operations, retires and frees") {
+        config.trace_events = 100;  /* Rounded up to 128 */
+        ll_domain_t *domain = ll_domain_create_ex(&config);
+        REQUIRE(domain != nullptr);
+        REQUIRE(ll_thread_register(domain) == LL_OK);
+        ll_head_t list;
+        REQUIRE(ll_init(&list, domain) == LL_OK);
+
+        std::vector<test_item *> items;
+        for (int i = 0; i < 10; i++) {
+            items.push_back(create_item(i, i));
+            REQUIRE(ll_insert_head(&list, items.back()) == LL_OK);
+        }
+        REQUIRE(ll_remove(&list, items[2]) == LL_OK);
+        ll_iterator_t iter;
+        REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+        while (ll_iterator_next(&iter) != nullptr) {
+        }
+        ll_iterator_end(&iter);
+        ll_reclaim(&list, test_item_free_void);
+
+        std::string text = trace_dump_string(domain);
+        REQUIRE(text.size() > 2);
+        REQUIRE(text.compare(text.size() - 3, 3, "]}\n") == 0);
+        REQUIRE(count_substr(text, "\"name\":\"insert\"") == 10);
+        REQUIRE(count_substr(text, "\"name\":\"remove\"") == 1);
+        REQUIRE(count_substr(text, "\"name\":\"iterate\"") == 1);
+        REQUIRE(count_substr(text, "\"name\":\"reclaim\"") == 1);
+        REQUIRE(count_substr(text, "\"name\":\"retire\"") == 1);
+        REQUIRE(count_substr(text, "\"name\":\"free\",") == 1);
+        REQUIRE(count_substr(text, "\"name\":\"thread_name\"") == 1);
+
+        /* The ring keeps only the newest 128 events. */
+        for (int i = 0; i < 300; i++)
+            REQUIRE(ll_insert_head(&list, create_item(100 + i, i)) == LL_OK);
+        text = trace_dump_string(domain);
+        REQUIRE(count_substr(text, "\"name\":\"insert\"") == 128);
+        REQUIRE(count_substr(text, "\"name\":\"reclaim\"") == 0);
+
+        ll_destroy(&list, test_item_free_void);
+        ll_thread_unregister(domain);
+        ll_domain_destroy(domain);
+    }
+}
+
+TEST_CASE("New API: List health", "[concurrent_ll][new_api][health]")
+{
+    ll_domain_t *domain = ll_domain_create(0);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+    ll_list_health_t health;
+    REQUIRE(ll_list_health(nullptr, &health) == LL_ERR_INVAL);
+    REQUIRE(ll_list_health(&list, nullptr) == LL_ERR_INVAL);
+
+    REQUIRE(ll_list_health(&list, &health) == LL_OK);
+    REQUIRE(health.nodes == 0);
+    REQUIRE(health.tombstone_ratio == 0.0);
+
+    /* Chain is 9..0; removing 5, 4, 3 and 8 leaves a run of three. */
+    std::vector<test_item *> items;
+    for (int i = 0; i < 10; i++) {
+        items.push_back(create_item(i, i));
+        REQUIRE(ll_insert_head(&list, items.back()) == LL_OK);
+    }
+    for (int i : {3, 4, 5, 8})
+        REQUIRE(ll_remove(&list, items[i]) == LL_OK);
+
+    REQUIRE(ll_list_health(&list, &health) == LL_OK);
+    REQUIRE(health.commit_id == list.commit_id.load());
+    REQUIRE(health.nodes == 10);
+    REQUIRE(health.tombstones == 4);
+    REQUIRE(health.invisible == 4);
+    REQUIRE(health.longest_invisible_run == 3);
+    REQUIRE(health.tombstone_ratio == Approx(0.4));
+
+    ll_reclaim(&list, test_item_free_void);
+    REQUIRE(ll_list_health(&list, &health) == LL_OK);
+    REQUIRE(health.nodes == 6);
+    REQUIRE(health.tombstones == 0);
+    REQUIRE(health.longest_invisible_run == 0);
+
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+TEST_CASE("New API: Domain health", "[concurrent_ll][new_api][health]")
+{
+    ll_domain_config_t config = {};
+    config.hp_slots = 3;
+    ll_domain_t *domain = ll_domain_create_ex(&config);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+    ll_domain_health_t health;
+    ll_thread_health_t threads[4];
+    REQUIRE(ll_domain_health(nullptr, &health, nullptr, 0) == LL_ERR_INVAL);
+    REQUIRE(ll_domain_health(domain, nullptr, nullptr, 0) == LL_ERR_INVAL);
+    REQUIRE(ll_domain_health(domain, &health, nullptr, 1) == LL_ERR_INVAL);
+
+    std::vector<test_item *> items;
+    for (int i = 0; i < 10; i++) {
+        items.push_back(create_item(i, i));
+        REQUIRE(ll_insert_head(&list, items.back()) == LL_OK);
+    }
+
+    /* A hazard on item 2 keeps its node retired but unfreed. */
+    int slot = ll_hazard_reserve(domain, 1);
+    REQUIRE(slot >= 0);
+    REQUIRE(ll_hazard_set(domain, slot, items[2]) == LL_OK);
+    REQUIRE(ll_remove(&list, items[2]) == LL_OK);
+    REQUIRE(ll_remove(&list, items[3]) == LL_OK);
+    ll_reclaim(&list, test_item_free_void);
+
+    REQUIRE(ll_domain_health(domain, &health, threads, 4) == LL_OK);
+    REQUIRE(health.threads == 1);
+    REQUIRE(health.slots == 1);
+    REQUIRE(health.retired == 1);
+    REQUIRE(health.hazard_held == 1);
+    REQUIRE(health.retired_max == 1);
+    REQUIRE(health.retired_max_slot == 0);
+    REQUIRE(health.oldest_snapshot == 0);
+    REQUIRE(health.oldest_snapshot_slot == SIZE_MAX);
+    REQUIRE(threads[0].in_use);
+    REQUIRE(threads[0].retired == 1);
+    REQUIRE(threads[0].hazard_held == 1);
+
+    ll_iterator_t iter;
+    REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+    REQUIRE(ll_domain_health(domain, &health, nullptr, 0) == LL_OK);
+    REQUIRE(health.oldest_snapshot == ll_iterator_snapshot(&iter));
+    REQUIRE(health.oldest_snapshot_slot == 0);
+    ll_iterator_end(&iter);
+
+    /* A departing thread's held node moves to the orphans. */
+    REQUIRE(ll_hazard_set(domain, slot, items[5]) == LL_OK);
+    std::thread other([&]() {
+        ll_thread_register(domain);
+        ll_remove(&list, items[5]);
+        ll_reclaim(&list, test_item_free_void);
+        ll_thread_unregister(domain);
+    });
+    other.join();
+    REQUIRE(ll_domain_health(domain, &health, threads, 4) == LL_OK);
+    REQUIRE(health.threads == 1);
+    REQUIRE(health.slots == 2);
+    REQUIRE(health.orphans == 1);
+    REQUIRE(health.retired == 2);
+    REQUIRE_FALSE(threads[1].in_use);
+    REQUIRE(threads[1].retired == 0);
+
+    ll_hazard_clear(domain, slot);
+    ll_reclaim(&list, test_item_free_void);
+    REQUIRE(ll_domain_health(domain, &health, nullptr, 0) == LL_OK);
+    REQUIRE(health.retired == 0);
+    REQUIRE(health.orphans == 0);
+    REQUIRE(health.hazard_held == 0);
+    REQUIRE(health.retired_max_slot == SIZE_MAX);
+
+    ll_hazard_unreserve(domain, slot);
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+static std::string analyze_string(ll_head_t *list, ll_analyze_format_t format)
+{
+    FILE *f = tmpfile();
+    REQUIRE(f != nullptr);
+    REQUIRE(ll_debug_analyze(list, f, format) == LL_OK);
+    return stream_string(f);
+}
+
+TEST_CASE("New API: Layout analysis", "[concurrent_ll][new_api][health]")
+{
+    ll_domain_t *domain = ll_domain_create(0);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+    REQUIRE(ll_debug_analyze(nullptr, stdout, LL_ANALYZE_TEXT) == LL_ERR_INVAL);
+    REQUIRE(ll_debug_analyze(&list, nullptr, LL_ANALYZE_TEXT) == LL_ERR_INVAL);
+    REQUIRE(ll_debug_analyze(&list, stdout, (ll_analyze_format_t)7) == LL_ERR_INVAL);
+
+    /* Chain is 9..0; removing 6, 5 and 1 leaves invisible runs of 2 and 1. */
+    std::vector<test_item *> items;
+    for (int i = 0; i < 10; i++) {
+        items.push_back(create_item(i, i));
+        REQUIRE(ll_insert_head(&list, items.back()) == LL_OK);
+    }
+    for (int i : {1, 5, 6})
+        REQUIRE(ll_remove(&list, items[i]) == LL_OK);
+
+    SECTION("JSON") {
+        std::string text = analyze_string(&list, LL_ANALYZE_JSON);
+        REQUIRE(text.front() == '{');
+        REQUIRE(text.compare(text.size() - 3, 3, "}}\n") == 0);
+        REQUIRE(count_substr(text, "\"nodes\":10,") == 1);
+        REQUIRE(count_substr(text, "\"markers\":0,") == 1);
+        REQUIRE(count_substr(text, "\"visible\":7,\"invisible\":3,\"visible_runs\":3,"
+                                   "\"invisible_runs\":2,\"longest_invisible_run\":2,"
+                                   "\"invisible_run_log2\":[1,1]}") == 1);
+        REQUIRE(count_substr(text, "\"stride\":{\"forward\":") == 1);
+        REQUIRE(count_substr(text, "\"pages\":{\"page_size\":") == 1);
+        REQUIRE(count_substr(text, "\"element\":{\"same_line\":") == 1);
+    }
+
+    SECTION("Text") {
+        std::string text = analyze_string(&list, LL_ANALYZE_TEXT);
+        REQUIRE(count_substr(text, ": 10 nodes (0 markers)") == 1);
+        REQUIRE(count_substr(text, "7 visible in 3 runs, 3 invisible in 2 runs, "
+                                   "longest invisible run 2") == 1);
+    }
+
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+TEST_CASE("New API: Reclaim blockers", "[concurrent_ll][new_api][health]")
+{
+    ll_domain_config_t config = {};
+    config.hp_slots = 3;
+    config.trace_events = 64;
+    config.track_blockers = true;
+    ll_domain_t *domain = ll_domain_create_ex(&config);
+    REQUIRE(ll_thread_set_name(domain, "main") == LL_ERR_NOTHREAD);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    REQUIRE(ll_thread_set_name(domain, nullptr) == LL_ERR_INVAL);
+    REQUIRE(ll_thread_set_name(domain, "main \"loop\"") == LL_OK);
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+    ll_blocker_t top[4];
+    REQUIRE(ll_domain_top_blockers(nullptr, top, 4) == LL_ERR_INVAL);
+    REQUIRE(ll_domain_top_blockers(domain, nullptr, 1) == LL_ERR_INVAL);
+    REQUIRE(ll_domain_top_blockers(domain, top, 4) == 0);
+
+    std::vector<test_item *> items;
+    for (int i = 0; i < 10; i++) {
+        items.push_back(create_item(i, i));
+        REQUIRE(ll_insert_head(&list, items.back()) == LL_OK);
+    }
+
+    std::atomic<int> phase{0};
+    std::thread reader([&]() {
+        ll_thread_register(domain);
+        ll_thread_set_name(domain, "reader-with-a-name-longer-than-the-limit");
+        ll_iterator_t iter;
+        ll_iterator_begin(&list, &iter);
+        phase.store(1);
+        while (phase.load() != 2)
+            std::this_thread::yield();
+        ll_iterator_end(&iter);
+        phase.store(3);
+        while (phase.load() != 4)
+            std::this_thread::yield();
+        ll_thread_unregister(domain);
+    });
+    while (phase.load() != 1)
+        std::this_thread::yield();
+
+    /* The reader's open snapshot holds back three tombstones. */
+    for (int i : {1, 2, 3})
+        REQUIRE(ll_remove(&list, items[i]) == LL_OK);
+    ll_reclaim(&list, test_item_free_void);
+    REQUIRE(ll_domain_top_blockers(domain, top, 4) == 1);
+    REQUIRE(top[0].slot == 1);
+    REQUIRE(top[0].snapshot_holds == 3);
+    REQUIRE(top[0].active_snapshot != 0);
+    REQUIRE(std::string(top[0].name) == "reader-with-a-name-longer-than-");
+    std::string trace = trace_dump_string(domain);
+    REQUIRE(count_substr(trace, "\"name\":\"main \\\"loop\\\" (slot 0)\"") == 1);
+    REQUIRE(count_substr(trace, "than- (slot 1)\"") == 1);
+
+    /* Then our own hazard keeps a retired node. */
+    phase.store(2);
+    while (phase.load() != 3)
+        std::this_thread::yield();
+    int slot = ll_hazard_reserve(domain, 1);
+    REQUIRE(slot >= 0);
+    REQUIRE(ll_hazard_set(domain, slot, items[7]) == LL_OK);
+    REQUIRE(ll_remove(&list, items[7]) == LL_OK);
+    ll_reclaim(&list, test_item_free_void);
+    REQUIRE(ll_domain_top_blockers(domain, top, 4) == 2);
+    REQUIRE(top[0].slot == 1);
+    REQUIRE(top[0].active_snapshot == 0);
+    REQUIRE(top[1].slot == 0);
+    REQUIRE(top[1].hazard_holds == 1);
+    REQUIRE(top[1].snapshot_holds == 0);
+    REQUIRE(ll_domain_top_blockers(domain, top, 1) == 1);
+    REQUIRE(top[0].slot == 1);
+
+    REQUIRE(ll_domain_blockers_reset(domain) == LL_OK);
+    REQUIRE(ll_domain_top_blockers(domain, top, 4) == 0);
+
+    ll_hazard_clear(domain, slot);
+    ll_hazard_unreserve(domain, slot);
+    ll_reclaim(&list, test_item_free_void);
+    phase.store(4);
+    reader.join();
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+static std::string prometheus_string(ll_domain_t *domain)
+{
+    int len = ll_stats_format_prometheus(domain, nullptr, 0);
+    std::string text(len > 0 ? (size_t)len : 0, '\0');
+    if (len > 0)
+        ll_stats_format_prometheus(domain, &text[0], text.size() + 1);
+    return text;
+}
+
+TEST_CASE("New API: Prometheus export", "[concurrent_ll][new_api][stats]")
+{
+    ll_domain_t *domain = ll_domain_create(4);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    ll_head_t orders, jobs, plain;
+    ll_list_config_t config = {};
+    for (const char *bad : {"name=orders", "1st=\"x\"", "__name=\"x\"", "name=\"x\",",
+                            "name=\"x\\t\"", "name=\"x\" ", "name=\"unterminated"}) {
+        config.labels = bad;
+        REQUIRE(ll_init_ex(&orders, domain, &config) == LL_ERR_INVAL);
+    }
+    config.labels = "name=\"orders\"";
+    REQUIRE(ll_init_ex(&orders, domain, &config) == LL_OK);
+    config.labels = "name=\"jobs\",shard=\"2\",note=\"say \\\"hi\\\"\"";
+    config.flags = LL_LIST_STRIPED;
+    REQUIRE(ll_init_ex(&jobs, domain, &config) == LL_OK);
+    REQUIRE(ll_init(&plain, domain) == LL_OK);
+    for (int i = 0; i < 3; i++) {
+        REQUIRE(ll_insert_head(&orders, create_item(i, i)) == LL_OK);
+        REQUIRE(ll_insert_head(&plain, create_item(i, i)) == LL_OK);
+    }
+
+    char small[16];
+    REQUIRE(ll_stats_format_prometheus(nullptr, small, sizeof(small)) == LL_ERR_INVAL);
+    REQUIRE(ll_stats_format_prometheus(domain, nullptr, 1) == LL_ERR_INVAL);
+    int len = ll_stats_format_prometheus(domain, small, sizeof(small));
+    REQUIRE(len >= (int)sizeof(small));
+    REQUIRE(std::string(small).size() == sizeof(small) - 1);
+
+    std::string text = prometheus_string(domain);
+    REQUIRE(text.size() == (size_t)len);
+    REQUIRE(text.compare(0, 15, small) == 0);
+    REQUIRE(count_substr(text, "\nll_threads 1\n") == 1);
+    REQUIRE(count_substr(text, "# TYPE ll_list_commits_total counter\n") == 1);
+    REQUIRE(count_substr(text, "\nll_list_commits_total{name=\"orders\"} 3\n") == 1);
+    REQUIRE(count_substr(text, "\nll_list_stripes{name=\"jobs\",shard=\"2\",note=\"say \\\"hi\\\"\"} ") == 1);
+    REQUIRE(count_substr(text, "ll_list_waiters{") == 2);
+#ifdef LL_STATS
+    REQUIRE(count_substr(text, "\nll_operations_total{op=\"insert\"} 6\n") == 1);
+#else
+    REQUIRE(count_substr(text, "ll_operations_total") == 0);
+#endif
+#ifdef LL_HISTOGRAMS
+    REQUIRE(count_substr(text, "# TYPE ll_operation_duration_seconds histogram\n") == 1);
+    REQUIRE(count_substr(text, "ll_operation_duration_seconds_bucket{op=\"insert\",le=\"+Inf\"} 6\n") == 1);
+    REQUIRE(count_substr(text, "ll_operation_duration_seconds_bucket{op=\"insert\",le=\"1.5e-08\"} ") == 1);
+#else
+    REQUIRE(count_substr(text, "ll_operation_duration_seconds") == 0);
+#endif
+
+    /* Destroyed lists leave the export; with none left, the families go too. */
+    ll_destroy(&orders, test_item_free_void);
+    text = prometheus_string(domain);
+    REQUIRE(count_substr(text, "orders") == 0);
+    REQUIRE(count_substr(text, "ll_list_waiters{") == 1);
+    ll_destroy(&jobs, test_item_free_void);
+    REQUIRE(count_substr(prometheus_string(domain), "ll_list_") == 0);
+
+    ll_destroy(&plain, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+TEST_CASE("New API: List heat", "[concurrent_ll][new_api][health]")
+{
+    ll_domain_config_t config = {};
+    config.track_contention = true;
+    ll_domain_t *domain = ll_domain_create_ex(&config);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    ll_head_t hot, busy, idle;
+    ll_list_config_t list_config = {};
+    list_config.labels = "name=\"hot\"";
+    REQUIRE(ll_init_ex(&hot, domain, &list_config) == LL_OK);
+    REQUIRE(ll_init(&busy, domain) == LL_OK);
+    REQUIRE(ll_init(&idle, domain) == LL_OK);
+
+    ll_list_heat_t top[4];
+    REQUIRE(ll_domain_top_contended(nullptr, top, 4) == LL_ERR_INVAL);
+    REQUIRE(ll_domain_top_contended(domain, nullptr, 1) == LL_ERR_INVAL);
+    REQUIRE(ll_domain_top_contended(domain, top, 4) == 0);
+
+    /* Three readers hold iterators on hot at once. */
+    for (int i = 0; i < 2; i++)
+        REQUIRE(ll_insert_head(&hot, create_item(i, i)) == LL_OK);
+    std::atomic<int> open{0}, release{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; t++) {
+        readers.emplace_back([&]() {
+            ll_thread_register(domain);
+            ll_iterator_t iter;
+            ll_iterator_begin(&hot, &iter);
+            open.fetch_add(1);
+            while (!release.load())
+                std::this_thread::yield();
+            ll_iterator_end(&iter);
+            ll_thread_unregister(domain);
+        });
+    }
+    while (open.load() != 3)
+        std::this_thread::yield();
+    REQUIRE(ll_domain_top_contended(domain, top, 4) == 1);
+    REQUIRE(top[0].readers == 3);
+    release.store(1);
+    for (auto &t : readers)
+        t.join();
+
+    /* Concurrent inserts make busy the hottest. */
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; t++) {
+        writers.emplace_back([&, t]() {
+            ll_thread_register(domain);
+            for (int i = 0; i < 2000; i++)
+                ll_insert_head(&busy, create_item(t * 2000 + i, i));
+            ll_thread_unregister(domain);
+        });
+    }
+    for (auto &t : writers)
+        t.join();
+
+    REQUIRE(ll_domain_top_contended(domain, top, 4) == 2);
+    REQUIRE(top[0].list == &busy);
+    REQUIRE(top[0].commits == 8000);
+    REQUIRE(top[0].labels == nullptr);
+    REQUIRE(top[1].list == &hot);
+    REQUIRE(top[1].commits == 2);
+    REQUIRE(top[1].cas_failures == 0);
+    REQUIRE(top[1].readers == 0);
+    REQUIRE(top[1].readers_max == 3);
+    REQUIRE(std::string(top[1].labels) == "name=\"hot\"");
+#ifdef LL_STATS
+    ll_stats_t stats;
+    REQUIRE(ll_domain_stats(domain, &stats) == LL_OK);
+    REQUIRE(top[0].cas_failures == stats.insert_retries);
+#endif
+    REQUIRE(ll_domain_top_contended(domain, top, 1) == 1);
+    REQUIRE(top[0].list == &busy);
+
+    std::string text = prometheus_string(domain);
+    REQUIRE(count_substr(text, "\nll_list_readers_max{name=\"hot\"} 3\n") == 1);
+    REQUIRE(count_substr(text, "\nll_list_cas_failures_total{name=\"hot\"} 0\n") == 1);
+
+    ll_destroy(&busy, test_item_free_void);
+    REQUIRE(ll_domain_top_contended(domain, top, 4) == 1);
+    ll_destroy(&hot, test_item_free_void);
+    ll_destroy(&idle, test_item_free_void);
+    REQUIRE(ll_domain_top_contended(domain, top, 4) == 0);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+
+    /* Domains without track_contention keep no counters. */
+    domain = ll_domain_create(4);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    REQUIRE(ll_init(&busy, domain) == LL_OK);
+    REQUIRE(ll_insert_head(&busy, create_item(0, 0)) == LL_OK);
+    REQUIRE(ll_domain_top_contended(domain, top, 4) == 0);
+    ll_destroy(&busy, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+TEST_CASE("New API: Flat-combining list", "[concurrent_ll][new_api][combining]")
+{
+    ll_domain_t *domain = ll_domain_create(0);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+
+    ll_head_t list;
+    ll_list_config_t config = {};
+    config.flags = 0x80;
+    REQUIRE(ll_init_ex(&list, domain, &config) == LL_ERR_INVAL);
+    config.flags = LL_LIST_COMBINING;
+    REQUIRE(ll_init_ex(&list, domain, &config) == LL_OK);
+
+    SECTION("Single thread keeps LIFO order and snapshots")
+    {
+        test_item *a = create_item(1, 10);
+        test_item *b = create_item(2, 20);
+        test_item *c = create_item(3, 30);
+        REQUIRE(ll_insert_head(&list, a) == LL_OK);
+        REQUIRE(ll_insert_head(&list, b) == LL_OK);
+        REQUIRE(ll_insert_head(&list, c) == LL_OK);
+        REQUIRE(ll_count(&list) == 3);
+
+        ll_iterator_t iter;
+        REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+        REQUIRE(ll_iterator_next(&iter) == c);
+        REQUIRE(ll_remove(&list, b) == LL_OK);
+        REQUIRE(ll_iterator_next(&iter) == b);
+        REQUIRE(ll_iterator_next(&iter) == a);
+        ll_iterator_end(&iter);
+
+        void *out = nullptr;
+        REQUIRE(ll_remove_first(&list, &out) == LL_OK);
+        REQUIRE(out == c);
+        REQUIRE(ll_remove_first(&list, &out) == LL_OK);
+        REQUIRE(out == a);
+        out = nullptr;
+        REQUIRE(ll_remove_first(&list, &out) == LL_ERR_NOTFOUND);
+        REQUIRE(out == nullptr);
+
+        delete c;
+        delete a;
+        ll_reclaim(&list, test_item_free_void);
+    }
+
+    SECTION("Concurrent inserts and pops hand over every element once")
+    {
+        const int num_threads = 8;
+        const int items_per_thread = 500;
+        const int total = num_threads * items_per_thread;
+        std::vector<std::atomic<int>> popped(total);
+        std::vector<test_item *> items(total);
+        for (int i = 0; i < total; i++)
+            items[i] = create_item(i, i);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&, t]() {
+                ll_thread_register(domain);
+                for (int i = 0; i < items_per_thread; i++) {
+                    ll_insert_head(&list, items[t * items_per_thread + i]);
+                    void *out = nullptr;
+                    if ((i & 1) && ll_remove_first(&list, &out) == LL_OK)
+                        popped[static_cast<test_item *>(out)->id].fetch_add(1);
+                }
+                ll_thread_unregister(domain);
+            });
+        }
+        for (auto &t : threads)
+            t.join();
+
+        void *out = nullptr;
+        while (ll_remove_first(&list, &out) == LL_OK)
+            popped[static_cast<test_item *>(out)->id].fetch_add(1);
+
+        for (int i = 0; i < total; i++)
+            REQUIRE(popped[i].load() == 1);
+        REQUIRE(ll_is_empty(&list));
+
+        for (test_item *item : items)
+            delete item;
+    }
+
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+TEST_CASE("New API: Elimination list", "[concurrent_ll][new_api][elimination]")
+{
+    ll_domain_t *domain = ll_domain_create(0);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+
+    ll_head_t list;
+    ll_list_config_t config = {};
+    config.flags = LL_LIST_ELIMINATION;
+    REQUIRE(ll_init_ex(&list, domain, &config) == LL_OK);
+
+    /* Producers and consumers collide on the head; nothing is lost or duplicated. */
+    const int num_pairs = 4;
+    const int items_per_producer = 1000;
+    const int total = num_pairs * items_per_producer;
+    std::vector<std::atomic<int>> popped(total);
+    std::vector<test_item *> items(total);
+    for (int i = 0; i < total; i++)
+        items[i] = create_item(i, i);
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_pairs; t++) {
+        threads.emplace_back([&, t]() {
+            ll_thread_register(domain);
+            for (int i = 0; i < items_per_producer; i++)
+                ll_insert_head(&list, items[t * items_per_producer + i]);
+            ll_thread_unregister(domain);
+        });
+        threads.emplace_back([&]() {
+            ll_thread_register(domain);
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (consumed.load() < total && std::chrono::steady_clock::now() < deadline) {
+                void *out = nullptr;
+                if (ll_remove_first(&list, &out) == LL_OK) {
+                    popped[static_cast<test_item *>(out)->id].fetch_add(1);
+                    consumed.fetch_add(1);
+                }
+            }
+            ll_thread_unregister(domain);
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    void *out = nullptr;
+    while (ll_remove_first(&list, &out) == LL_OK)
+        popped[static_cast<test_item *>(out)->id].fetch_add(1);
+    for (int i = 0; i < total; i++)
+        REQUIRE(popped[i].load() == 1);
+
+    for (test_item *item : items)
+        delete item;
+    ll_destroy(&list, nullptr);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+TEST_CASE("New API: Insert striping", "[concurrent_ll][new_api][striping]")
+{
+    ll_domain_t *domain = ll_domain_create(0);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+
+    ll_head_t list;
+    ll_list_config_t config = {};
+    config.flags = LL_LIST_STRIPED;
+    REQUIRE(ll_init_ex(&list, domain, &config) == LL_OK);
+    REQUIRE(ll_list_stripes(&list) >= 2);
+
+    SECTION("Striped inserts keep snapshot, remove and count semantics")
+    {
+        const int num_threads = 4;
+        const int items_per_thread = 50;
+        const int total = num_threads * items_per_thread;
+        std::vector<test_item *> items(total);
+        for (int i = 0; i < total; i++)
+            items[i] = create_item(i, i);
+
+        ll_iterator_t old_iter;
+        REQUIRE(ll_iterator_begin(&list, &old_iter) == LL_OK);
+
+        /* Registered threads spread over the stripes by slot. */
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&, t]() {
+                ll_thread_register(domain);
+                for (int i = 0; i < items_per_thread; i++)
+                    ll_insert_head(&list, items[t * items_per_thread + i]);
+                ll_thread_unregister(domain);
+            });
+        }
+        for (auto &t : threads)
+            t.join();
+
+        REQUIRE(ll_iterator_next(&old_iter) == nullptr);
+        ll_iterator_end(&old_iter);
+
+        REQUIRE(ll_count(&list) == static_cast<size_t>(total));
+        REQUIRE(ll_contains(&list, items[total - 1]));
+        REQUIRE(ll_remove(&list, items[0]) == LL_OK);
+        REQUIRE(ll_count(&list) == static_cast<size_t>(total - 1));
+
+        /* Each thread's items come back newest first. */
+        std::vector<int> last_seen(num_threads, items_per_thread);
+        ll_iterator_t iter;
+        REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+        int seen = 0;
+        void *elm;
+        while ((elm = ll_iterator_next(&iter)) != nullptr) {
+            test_item *item = static_cast<test_item *>(elm);
+            int t = item->id / items_per_thread;
+            int i = item->id % items_per_thread;
+            REQUIRE(i < last_seen[t]);
+            last_seen[t] = i;
+            seen++;
+        }
+        ll_iterator_end(&iter);
+        REQUIRE(seen == total - 1);
+
+        ll_reclaim(&list, test_item_free_void);
+    }
+
+    SECTION("Quiet inserts deflate the list")
+    {
+        std::vector<test_item *> items;
+        for (int i = 0; i < 200 && ll_list_stripes(&list) != 0; i++) {
+            items.push_back(create_item(i, i));
+            REQUIRE(ll_insert_head(&list, items.back()) == LL_OK);
+        }
+        REQUIRE(ll_list_stripes(&list) == 0);
+
+        test_item *after = create_item(1000, 0);
+        REQUIRE(ll_insert_head(&list, after) == LL_OK);
+        void *out = nullptr;
+        REQUIRE(ll_remove_first(&list, &out) == LL_OK);
+        REQUIRE(out == after);
+        delete after;
+        REQUIRE(ll_count(&list) == items.size());
+    }
+
+    SECTION("Combining lists never stripe")
+    {
+        ll_head_t combined;
+        config.flags = LL_LIST_STRIPED | LL_LIST_COMBINING;
+        REQUIRE(ll_init_ex(&combined, domain, &config) == LL_ERR_INVAL);
+
+        /* Contended inserts would inflate a plain list; every pop must still see them. */
+        config.flags = LL_LIST_COMBINING | LL_LIST_ELIMINATION;
+        REQUIRE(ll_init_ex(&combined, domain, &config) == LL_OK);
+        const int num_threads = 4;
+        const int items_per_thread = 500;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&, t]() {
+                ll_thread_register(domain);
+                for (int i = 0; i < items_per_thread; i++)
+                    ll_insert_head(&combined, create_item(t * items_per_thread + i, i));
+                ll_thread_unregister(domain);
+            });
+        }
+        for (auto &t : threads)
+            t.join();
+
+        REQUIRE(ll_list_stripes(&combined) == 0);
+        int popped = 0;
+        void *out = nullptr;
+        while (ll_remove_first(&combined, &out) == LL_OK) {
+            delete static_cast<test_item *>(out);
+            popped++;
+        }
+        REQUIRE(popped == num_threads * items_per_thread);
+        ll_destroy(&combined, test_item_free_void);
+    }
+
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
+/* ==================== New API: Blocking Remove Tests ==================== */
+
+TEST_CASE("New API: Per-CPU insert buffers", "[concurrent_ll][new_api][percpu]")
+{
+    ll_domain_t *domain = ll_domain_create(0);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+
+    ll_head_t list;
+    ll_list_config_t config = {};
+    config.flags = LL_LIST_PERCPU | LL_LIST_COMBINING;
+    REQUIRE(ll_init_ex(&list, domain, &config) == LL_ERR_INVAL);
+    config.flags = LL_LIST_PERCPU;
+    REQUIRE(ll_init_ex(&list, domain, &config) == LL_OK);
+    unsigned buffers = ll_list_stripes(&list);
+    REQUIRE(buffers >= 1);
+
+    SECTION("Buffered inserts take txn ids when merged")
+    {
+        test_item *a = create_item(1, 1);
+        test_item *b = create_item(2, 2);
+        ll_iterator_t old_iter;
+        REQUIRE(ll_iterator_begin(&list, &old_iter) == LL_OK);
+
+        REQUIRE(ll_insert_head(&list, a) == LL_OK);
+        REQUIRE(ll_insert_head(&list, b) == LL_OK);
+        REQUIRE(atomic_load(&list.commit_id) == 1);  /* Still buffered */
+
+        REQUIRE(ll_iterator_next(&old_iter) == nullptr);
+        ll_iterator_end(&old_iter);
+        REQUIRE(ll_count(&list) == 2);
+        REQUIRE(atomic_load(&list.commit_id) == 3);
+
+        void *out = nullptr;
+        REQUIRE(ll_remove_first(&list, &out) == LL_OK);
+        REQUIRE(out == b);
+        REQUIRE(ll_remove_first(&list, &out) == LL_OK);
+        REQUIRE(out == a);
+        delete a;
+        delete b;
+    }
+
+    SECTION("Full buffers merge without a reader")
+    {
+        /* Some buffer must reach its flush threshold. */
+        const int total = static_cast<int>(buffers) * 64;
+        for (int i = 0; i < total; i++)
+            REQUIRE(ll_insert_head(&list, create_item(i, i)) == LL_OK);
+        REQUIRE(atomic_load(&list.commit_id) > 1);
+        REQUIRE(ll_count(&list) == static_cast<size_t>(total));
+    }
+
+    SECTION("Concurrent inserts keep per-thread order")
+    {
+        const int num_threads = 4;
+        const int items_per_thread = 500;
+        const int total = num_threads * items_per_thread;
+        std::vector<test_item *> items(total);
+        for (int i = 0; i < total; i++)
+            items[i] = create_item(i, i);
+
+        std::atomic<bool> done{false};
+        std::thread reader([&]() {
+            ll_thread_register(domain);
+            while (!done.load())
+                ll_count(&list);
+            ll_thread_unregister(domain);
+        });
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&, t]() {
+                ll_thread_register(domain);
+                for (int i = 0; i < items_per_thread; i++)
+                    ll_insert_head(&list, items[t * items_per_thread + i]);
+                ll_thread_unregister(domain);
+            });
+        }
+        for (auto &t : threads)
+            t.join();
+        done.store(true);
+        reader.join();
+
+        std::vector<int> last_seen(num_threads, items_per_thread);
+        ll_iterator_t iter;
+        REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+        int seen = 0;
+        void *elm;
+        while ((elm = ll_iterator_next(&iter)) != nullptr) {
+            test_item *item = static_cast<test_item *>(elm);
+            int t = item->id / items_per_thread;
+            int i = item->id % items_per_thread;
+            REQUIRE(i < last_seen[t]);
+            last_seen[t] = i;
+            seen++;
+        }
+        ll_iterator_end(&iter);
+        REQUIRE(seen == total);
+    }
+
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
 
-    SECTION("ll_count on list with elements")
-    {
-        for (int i = 0; i < 5; i++) {
-            ll_insert_head(&list, create_item(i, i * 10));
+TEST_CASE("New API: Wait-free insert", "[concurrent_ll][new_api][waitfree]")
+{
+    ll_domain_t *domain = ll_domain_create(0);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+
+    ll_head_t list;
+    ll_list_config_t config = {};
+    config.flags = LL_LIST_WAITFREE | LL_LIST_STRIPED;
+    REQUIRE(ll_init_ex(&list, domain, &config) == LL_ERR_INVAL);
+    config.flags = LL_LIST_WAITFREE;
+    REQUIRE(ll_init_ex(&list, domain, &config) == LL_OK);
+
+    const int num_threads = 4;
+    const int items_per_thread = 500;
+    const int total = num_threads * items_per_thread;
+    std::vector<test_item *> items(total);
+    for (int i = 0; i < total; i++)
+        items[i] = create_item(i, i);
+
+    /* Readers and a popper traverse while inserts are in flight. */
+    std::atomic<bool> done{false};
+    std::vector<int> popped;
+    std::thread reader([&]() {
+        ll_thread_register(domain);
+        while (!done.load()) {
+            ll_count(&list);
+            ll_contains(&list, items[0]);
         }
-        REQUIRE(ll_count(&list) == 5);
-        ll_destroy(&list, test_item_free_void);
+        ll_thread_unregister(domain);
+    });
+    std::thread popper([&]() {
+        ll_thread_register(domain);
+        void *out = nullptr;
+        while (!done.load() && popped.size() < static_cast<size_t>(total / 4)) {
+            if (ll_remove_first(&list, &out) == LL_OK)
+                popped.push_back(static_cast<test_item *>(out)->id);
+        }
+        ll_thread_unregister(domain);
+    });
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            ll_thread_register(domain);
+            for (int i = 0; i < items_per_thread; i++)
+                ll_insert_head(&list, items[t * items_per_thread + i]);
+            ll_thread_unregister(domain);
+        });
     }
+    for (auto &t : threads)
+        t.join();
+    done.store(true);
+    reader.join();
+    popper.join();
 
-    SECTION("ll_count with null list")
-    {
-        REQUIRE(ll_count(nullptr) == 0);
+    /* Every element is either popped or still listed, newest first per thread. */
+    std::vector<int> seen(total, 0);
+    for (int id : popped)
+        seen[id]++;
+    std::vector<int> last_seen(num_threads, items_per_thread);
+    ll_iterator_t iter;
+    REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+    void *elm;
+    while ((elm = ll_iterator_next(&iter)) != nullptr) {
+        test_item *item = static_cast<test_item *>(elm);
+        int t = item->id / items_per_thread;
+        int i = item->id % items_per_thread;
+        REQUIRE(i < last_seen[t]);
+        last_seen[t] = i;
+        seen[item->id]++;
     }
+    ll_iterator_end(&iter);
+    for (int i = 0; i < total; i++)
+        REQUIRE(seen[i] == 1);
 
+    for (int id : popped)
+        delete items[id];
+    ll_destroy(&list, test_item_free_void);
     ll_thread_unregister(domain);
     ll_domain_destroy(domain);
 }
 
-/* ==================== New API: List Destroy Tests ==================== */
-
-TEST_CASE("New API: List destroy", "[concurrent_ll][new_api][destroy]")
+TEST_CASE("New API: Blocking remove_first", "[concurrent_ll][new_api][wait]")
 {
-    ll_domain_t *domain = ll_domain_create(4);
-    REQUIRE(domain != nullptr);
+    ll_domain_t *domain = ll_domain_create(0);
     REQUIRE(ll_thread_register(domain) == LL_OK);
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
 
-    SECTION("Destroy empty list")
+    SECTION("Empty list times out")
     {
-        ll_head_t list;
-        REQUIRE(ll_init(&list, domain) == LL_OK);
-        ll_destroy(&list, nullptr);  /* No callback needed for empty list. */
+        void *out = nullptr;
+        /* A zero timeout polls, like ll_remove_first(). */
+        REQUIRE(ll_remove_first_wait(&list, &out, 0) == LL_ERR_NOTFOUND);
+
+        auto start = std::chrono::steady_clock::now();
+        REQUIRE(ll_remove_first_wait(&list, &out, 50) == LL_ERR_TIMEDOUT);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        REQUIRE(elapsed >= std::chrono::milliseconds(45));
+        REQUIRE(out == nullptr);
     }
 
-    SECTION("Destroy list with elements and callback")
+    SECTION("Available element returns without waiting")
     {
-        ll_head_t list;
-        REQUIRE(ll_init(&list, domain) == LL_OK);
-
-        freed_count.store(0);
-        for (int i = 0; i < 5; i++) {
-            ll_insert_head(&list, create_item(i, i * 10));
-        }
-
-        ll_destroy(&list, test_item_free_void);
-        REQUIRE(freed_count.load() == 5);
+        test_item *item = create_item(1, 10);
+        REQUIRE(ll_insert_head(&list, item) == LL_OK);
+        void *out = nullptr;
+        REQUIRE(ll_remove_first_wait(&list, &out, -1) == LL_OK);
+        REQUIRE(out == item);
+        delete item;
     }
 
-    SECTION("Destroy list with elements without callback")
+    SECTION("Parked consumers are woken by inserts")
     {
-        ll_head_t list;
-        REQUIRE(ll_init(&list, domain) == LL_OK);
-
-        /* These items will leak if no callback, but test ensures no crash. */
-        for (int i = 0; i < 3; i++) {
-            ll_insert_head(&list, create_item(i, i * 10));
+        const int num_consumers = 4;
+        const int items_per_consumer = 100;
+        const int total = num_consumers * items_per_consumer;
+        std::vector<test_item *> items(total);
+        for (int i = 0; i < total; i++)
+            items[i] = create_item(i, i);
+        std::vector<std::atomic<int>> popped(total);
+        std::atomic<int> timeouts{0};
+
+        std::vector<std::thread> consumers;
+        for (int c = 0; c < num_consumers; c++) {
+            consumers.emplace_back([&]() {
+                ll_thread_register(domain);
+                for (int i = 0; i < items_per_consumer; i++) {
+                    void *out = nullptr;
+                    if (ll_remove_first_wait(&list, &out, 10000) == LL_OK)
+                        popped[static_cast<test_item *>(out)->id].fetch_add(1);
+                    else
+                        timeouts.fetch_add(1);
+                }
+                ll_thread_unregister(domain);
+            });
         }
 
-        ll_destroy(&list, nullptr);
-        /* No crash = success. Items leaked intentionally for this test. */
-    }
+        /* Let the consumers park before producing. */
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        for (int i = 0; i < total; i++) {
+            REQUIRE(ll_insert_head(&list, items[i]) == LL_OK);
+            if (i % 50 == 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        for (auto &t : consumers)
+            t.join();
 
-    SECTION("Destroy null list is safe")
-    {
-        ll_destroy(nullptr, test_item_free_void);  /* Should not crash. */
+        REQUIRE(timeouts.load() == 0);
+        for (int i = 0; i < total; i++)
+            REQUIRE(popped[i].load() == 1);
+        for (test_item *item : items)
+            delete item;
     }
 
+    ll_destroy(&list, nullptr);
     ll_thread_unregister(domain);
     ll_domain_destroy(domain);
 }
 
-/* ==================== New API: Reclaim Tests ==================== */
+#ifdef __linux__
+/* Read and return an eventfd's counter, or 0 if it is not signaled. */
+static uint64_t eventfd_take(int fd)
+{
+    uint64_t value = 0;
+    if (read(fd, &value, sizeof(value)) != sizeof(value))
+        return 0;
+    return value;
+}
 
-TEST_CASE("New API: Memory reclamation", "[concurrent_ll][new_api][reclaim]")
+TEST_CASE("New API: eventfd readiness", "[concurrent_ll][new_api][eventfd]")
 {
-    ll_domain_t *domain = ll_domain_create(4);
-    REQUIRE(domain != nullptr);
+    ll_domain_t *domain = ll_domain_create(0);
     REQUIRE(ll_thread_register(domain) == LL_OK);
-
     ll_head_t list;
     REQUIRE(ll_init(&list, domain) == LL_OK);
+    int efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    REQUIRE(efd >= 0);
 
-    SECTION("Reclaim frees removed nodes")
+    SECTION("Invalid arguments")
     {
-        freed_count.store(0);
-        test_item *item = create_item(1, 100);
-        ll_insert_head(&list, item);
-        ll_remove(&list, item);
-
-        ll_reclaim(&list, test_item_free_void);
-
-        /* Node should be freed. */
-        REQUIRE(freed_count.load() >= 1);
+        REQUIRE(ll_attach_eventfd(nullptr, efd, 0) == LL_ERR_INVAL);
+        REQUIRE(ll_attach_eventfd(&list, efd, 0x1u) == LL_ERR_INVAL);
     }
 
-    SECTION("Reclaim with no removed nodes is safe")
+    SECTION("Bursts coalesce until the consumer drains")
     {
-        test_item *item = create_item(1, 100);
-        ll_insert_head(&list, item);
+        REQUIRE(ll_attach_eventfd(&list, efd, 0) == LL_OK);
+        REQUIRE(eventfd_take(efd) == 1);  /* Signaled once on attach */
 
-        ll_reclaim(&list, nullptr);  /* No crash, nothing to reclaim. */
+        void *out = nullptr;
+        /* Not armed until a drain finds the list empty. */
+        REQUIRE(ll_insert_head(&list, create_item(0, 0)) == LL_OK);
+        REQUIRE(eventfd_take(efd) == 0);
+        REQUIRE(ll_remove_first(&list, &out) == LL_OK);
+        delete static_cast<test_item *>(out);
+        REQUIRE(ll_remove_first(&list, &out) == LL_ERR_NOTFOUND);
 
-        ll_destroy(&list, test_item_free_void);
+        for (int i = 1; i <= 3; i++)
+            REQUIRE(ll_insert_head(&list, create_item(i, i)) == LL_OK);
+        REQUIRE(eventfd_take(efd) == 1);
+        REQUIRE(eventfd_take(efd) == 0);
+
+        int drained = 0;
+        while (ll_remove_first(&list, &out) == LL_OK) {
+            delete static_cast<test_item *>(out);
+            drained++;
+        }
+        REQUIRE(drained == 3);
+        REQUIRE(ll_insert_head(&list, create_item(4, 4)) == LL_OK);
+        REQUIRE(eventfd_take(efd) == 1);
+
+        REQUIRE(ll_attach_eventfd(&list, -1, 0) == LL_OK);
+        REQUIRE(ll_remove_first(&list, &out) == LL_OK);
+        delete static_cast<test_item *>(out);
+        REQUIRE(ll_remove_first(&list, &out) == LL_ERR_NOTFOUND);
+        REQUIRE(ll_insert_head(&list, create_item(5, 5)) == LL_OK);
+        REQUIRE(eventfd_take(efd) == 0);
     }
 
-    SECTION("Reclaim with null list is safe")
+    SECTION("Poll loop consumer sees every element")
     {
-        ll_reclaim(nullptr, test_item_free_void);  /* Should not crash. */
+        REQUIRE(ll_attach_eventfd(&list, efd, 0) == LL_OK);
+        const int num_producers = 3;
+        const int items_per_producer = 300;
+        const int total = num_producers * items_per_producer;
+        std::vector<test_item *> items(total);
+        for (int i = 0; i < total; i++)
+            items[i] = create_item(i, i);
+        std::vector<int> popped(total, 0);
+        std::atomic<int> idle_polls{0};
+
+        std::thread consumer([&]() {
+            ll_thread_register(domain);
+            int got = 0;
+            struct pollfd pfd = {efd, POLLIN, 0};
+            while (got < total) {
+                if (poll(&pfd, 1, 10000) != 1) {
+                    idle_polls.fetch_add(1);
+                    break;
+                }
+                eventfd_take(efd);
+                void *out = nullptr;
+                while (ll_remove_first(&list, &out) == LL_OK) {
+                    popped[static_cast<test_item *>(out)->id]++;
+                    got++;
+                }
+            }
+            ll_thread_unregister(domain);
+        });
+
+        std::vector<std::thread> producers;
+        for (int p = 0; p < num_producers; p++) {
+            producers.emplace_back([&, p]() {
+                ll_thread_register(domain);
+                for (int i = 0; i < items_per_producer; i++) {
+                    ll_insert_head(&list, items[p * items_per_producer + i]);
+                    if (i % 64 == 0)
+                        std::this_thread::sleep_for(std::chrono::microseconds(200));
+                }
+                ll_thread_unregister(domain);
+            });
+        }
+        for (auto &t : producers)
+            t.join();
+        consumer.join();
+
+        REQUIRE(idle_polls.load() == 0);
+        for (int i = 0; i < total; i++)
+            REQUIRE(popped[i] == 1);
+        for (test_item *item : items)
+            delete item;
     }
 
+    ll_destroy(&list, test_item_free_void);
+    close(efd);
     ll_thread_unregister(domain);
     ll_domain_destroy(domain);
 }
+#endif
 
 /* ==================== New API: Concurrent Operations Tests ==================== */
 
@@ -827,6 +2746,65 @@ TEST_CASE("New API: Thread slot reuse after unregister", "[concurrent_ll][new_ap
     ll_domain_destroy(domain);
 }
 
+TEST_CASE("New API: Registration churn with held slots", "[concurrent_ll][new_api][thread][concurrent]")
+{
+    ll_domain_t *domain = ll_domain_create(2);
+    REQUIRE(domain != nullptr);
+
+    /* Keep some slots occupied while other threads churn through the rest. */
+    const int num_held = 8;
+    std::atomic<bool> release{false};
+    std::atomic<int> held{0};
+    std::vector<std::thread> holders;
+    for (int i = 0; i < num_held; i++) {
+        holders.emplace_back([&]() {
+            REQUIRE(ll_thread_register(domain) == LL_OK);
+            held.fetch_add(1);
+            while (!release.load())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ll_thread_unregister(domain);
+        });
+    }
+    while (held.load() < num_held)
+        std::this_thread::yield();
+
+    const int num_threads = 4;
+    const int rounds = 50;
+    std::atomic<int> errors{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            for (int r = 0; r < rounds; r++) {
+                if (ll_thread_register(domain) != LL_OK) {
+                    errors.fetch_add(1);
+                    continue;
+                }
+
+                /* A freshly obtained slot must be fully usable. */
+                ll_head_t list;
+                ll_init(&list, domain);
+                test_item *item = create_item(t * rounds + r, r);
+                void *out = nullptr;
+                if (ll_insert_head(&list, item) != LL_OK ||
+                    ll_remove_first(&list, &out) != LL_OK || out != item)
+                    errors.fetch_add(1);
+                delete item;
+
+                ll_thread_unregister(domain);
+            }
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    release.store(true);
+    for (auto &t : holders)
+        t.join();
+
+    REQUIRE(errors.load() == 0);
+    ll_domain_destroy(domain);
+}
+
 /* ==================== New API: Edge Cases ==================== */
 
 TEST_CASE("New API: Single element operations", "[concurrent_ll][new_api][edge]")
@@ -1177,6 +3155,77 @@ TEST_CASE("New API: Concurrent removes and reclaim", "[concurrent_ll][new_api][c
     ll_domain_destroy(domain);
 }
 
+static std::atomic<int> pop_race_freed{0};
+
+static void pop_race_free(void *item)
+{
+    pop_race_freed.fetch_add(1, std::memory_order_relaxed);
+    delete static_cast<test_item *>(item);
+}
+
+TEST_CASE("New API: Pops racing removes release each element once", "[concurrent_ll][new_api][concurrent][reclaim]")
+{
+    ll_domain_t *domain = ll_domain_create(8);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+
+    /*
+     * The remover chases the newest insert, which the popper is taking at
+     * the same time, while further inserts move the head so some pops
+     * cannot unlink what they claimed. Every element must come back
+     * exactly once: from a pop, or through free_cb.
+     */
+    const int total = 100000;
+    std::atomic<int> popped{0};
+    std::atomic<void *> newest{nullptr};
+    std::atomic<bool> done{false};
+    pop_race_freed.store(0);
+
+    std::thread inserter([&]() {
+        ll_thread_register(domain);
+        for (int i = 0; i < total; i++) {
+            test_item *item = create_item(i, i);
+            ll_insert_head(&list, item);
+            newest.store(item);
+        }
+        done.store(true);
+        ll_thread_unregister(domain);
+    });
+    std::thread popper([&]() {
+        ll_thread_register(domain);
+        void *out = nullptr;
+        while (!done.load()) {
+            if (ll_remove_first(&list, &out) == LL_OK) {
+                popped.fetch_add(1, std::memory_order_relaxed);
+                delete static_cast<test_item *>(out);
+            }
+        }
+        ll_thread_unregister(domain);
+    });
+    std::thread remover([&]() {
+        ll_thread_register(domain);
+        int n = 0;
+        while (!done.load()) {
+            void *elm = newest.load();
+            if (elm)
+                ll_remove(&list, elm);  /* Compares pointers only. */
+            if (++n % 64 == 0)
+                ll_reclaim(&list, pop_race_free);
+        }
+        ll_thread_unregister(domain);
+    });
+    inserter.join();
+    popper.join();
+    remover.join();
+
+    ll_reclaim(&list, pop_race_free);
+    ll_destroy(&list, pop_race_free);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+    REQUIRE(popped.load() + pop_race_freed.load() == total);
+}
+
 /* ==================== New API: Reclaim Without Thread Registration ==================== */
 
 TEST_CASE("New API: Reclaim without thread registration is safe", "[concurrent_ll][new_api][reclaim]")
@@ -2025,6 +4074,57 @@ TEST_CASE("Concurrent LL: Active snapshot prevents reclamation", "[concurrent_ll
      */
 }
 
+TEST_CASE("Concurrent LL: Pops racing removes release each element once", "[concurrent_ll][concurrent][memory]")
+{
+    struct test_list_head list;
+    ll_init(&list.head, &list.commit_id);
+
+    /* The legacy twin of the new-API test: pops claim what removes chase. */
+    const int total = 100000;
+    std::atomic<int> popped{0};
+    std::atomic<void *> newest{nullptr};
+    std::atomic<bool> done{false};
+    pop_race_freed.store(0);
+
+    std::thread inserter([&]() {
+        for (int i = 0; i < total; i++) {
+            test_item *item = create_item(i, i);
+            ll_insert_head(&list.head, &list.commit_id, item);
+            newest.store(item);
+        }
+        done.store(true);
+    });
+    std::thread popper([&]() {
+        while (!done.load()) {
+            void *out = ll_remove_head(&list.head, &list.commit_id);
+            if (out) {
+                popped.fetch_add(1, std::memory_order_relaxed);
+                delete static_cast<test_item *>(out);
+            }
+        }
+    });
+    std::thread remover([&]() {
+        int n = 0;
+        while (!done.load()) {
+            void *elm = newest.load();
+            if (elm)
+                ll_remove(&list.head, &list.commit_id, pop_race_free, elm);
+            if (++n % 64 == 0)
+                ll_reclaim(&list.head, &list.commit_id, pop_race_free);
+        }
+    });
+    inserter.join();
+    popper.join();
+    remover.join();
+
+    while (void *out = ll_remove_head(&list.head, &list.commit_id)) {
+        popped.fetch_add(1, std::memory_order_relaxed);
+        delete static_cast<test_item *>(out);
+    }
+    ll_reclaim(&list.head, &list.commit_id, pop_race_free);
+    REQUIRE(popped.load() + pop_race_freed.load() == total);
+}
+
 /* ==================== Legacy Iterator API Tests ==================== */
 
 TEST_CASE("Legacy Iterator: Basic iteration", "[concurrent_ll][legacy][iterator]")
@@ -2455,10 +4555,8 @@ TEST_CASE("pthread TLS: Thread exit without explicit unregister", "[concurrent_l
 {
     /*
      * Test behavior when threads terminate without calling ll_thread_unregister().
-     * Since we don't use pthread_key_create with destructors, the slot should
-     * remain "occupied" until the domain is destroyed, but new threads should
-     * still be able to register (domain grows or reuses slots from properly
-     * unregistered threads).
+     * The TLS key destructor releases the slot on thread exit, so new threads
+     * can reuse it.
      *
      * This test verifies:
      * 1. Threads can exit without unregister (no crash)
@@ -2533,6 +4631,41 @@ TEST_CASE("pthread TLS: Thread exit without explicit unregister", "[concurrent_l
     ll_domain_destroy(domain);
 }
 
+TEST_CASE("pthread TLS: Thread exit releases its snapshot", "[concurrent_ll][tls][pthread][reclaim]")
+{
+    /*
+     * A thread that exits mid-iteration without ll_iterator_end() or
+     * ll_thread_unregister() must not pin its snapshot forever.
+     */
+    ll_domain_t *domain = ll_domain_create(4);
+    REQUIRE(domain != nullptr);
+    REQUIRE(ll_thread_register(domain) == LL_OK);
+
+    ll_head_t list;
+    REQUIRE(ll_init(&list, domain) == LL_OK);
+
+    test_item *item = create_item(1, 100);
+    REQUIRE(ll_insert_head(&list, item) == LL_OK);
+
+    std::thread reader([&]() {
+        REQUIRE(ll_thread_register(domain) == LL_OK);
+        ll_iterator_t iter;
+        REQUIRE(ll_iterator_begin(&list, &iter) == LL_OK);
+        REQUIRE(ll_iterator_next(&iter) == item);
+        /* Exit while the snapshot is still active. */
+    });
+    reader.join();
+
+    freed_count.store(0);
+    REQUIRE(ll_remove(&list, item) == LL_OK);
+    ll_reclaim(&list, test_item_free_void);
+    REQUIRE(freed_count.load() == 1);
+
+    ll_destroy(&list, test_item_free_void);
+    ll_thread_unregister(domain);
+    ll_domain_destroy(domain);
+}
+
 TEST_CASE("pthread TLS: Concurrent TLS access stress", "[concurrent_ll][tls][pthread][stress]")
 {
     /*